@@ -0,0 +1,183 @@
+// The same hot paths through the C front-end in Wordle/, for comparison with
+// bench_cpp.cpp.
+#include "bench_util.hpp"
+
+extern "C" {
+#include "dictionary.h"
+#include "wordle_board.h"
+}
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <cstring>
+
+static void DictionaryArgs(benchmark::internal::Benchmark* b) {
+	for (int64_t size : { 1000, 10000, 100000 }) b->Args({ size });
+}
+
+static void LengthArgs(benchmark::internal::Benchmark* b) {
+	for (int64_t size : { 1000, 100000 }) {
+		for (int64_t len : { 4, 5, 8 }) b->Args({ size, len });
+	}
+}
+
+static void WordArgs(benchmark::internal::Benchmark* b) {
+	for (int64_t len : { 4, 5, 8 }) b->Args({ len });
+}
+
+static dict_t* load_dictionary(benchmark::State& state) {
+	if (bench_source_words().empty()) { state.SkipWithError("No source word list"); return nullptr; }
+
+	StdoutSilencer silence;
+	return dictionary_from_file(bench_word_file((size_t)state.range(0)).string().c_str(), DICT_LOAD_LOWER_ONLY);
+}
+
+static bool has_words_of_length(const dict_t* dict, size_t len) {
+	for (size_t i = 0; i < dictionary_word_count(dict); ++i) {
+		if (strlen(dictionary_get_word(dict, i)) == len) return true;
+	}
+	return false;
+}
+
+static void BM_C_DictionaryLoad(benchmark::State& state) {
+	if (bench_source_words().empty()) { state.SkipWithError("No source word list"); return; }
+	const auto path = bench_word_file((size_t)state.range(0)).string();
+
+	StdoutSilencer silence;
+	for (auto _ : state) {
+		dict_t* dict = dictionary_from_file(path.c_str(), DICT_LOAD_LOWER_ONLY);
+		benchmark::DoNotOptimize(dictionary_word_count(dict));
+		dictionary_destroy(dict);
+	}
+}
+BENCHMARK(BM_C_DictionaryLoad)->Apply(DictionaryArgs)->Unit(benchmark::kMicrosecond);
+
+static void BM_C_Contains(benchmark::State& state) {
+	const auto words = bench_words_of_length((size_t)state.range(1), 256);
+	if (words.empty()) { state.SkipWithError("No words of this length"); return; }
+	dict_t* dict = load_dictionary(state);
+	if (!dict) return;
+
+	size_t i = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(dictionary_contains(dict, words[i++ % words.size()].c_str()));
+	}
+	dictionary_destroy(dict);
+}
+BENCHMARK(BM_C_Contains)->Apply(LengthArgs);
+
+// Every thread looks words up in one list that isn't alphabetized, the case
+// that used to sort the shared list on first use.
+static dict_t* shared_unsorted_dictionary() {
+	static dict_t* shared = []() -> dict_t* {
+		if (bench_source_words().empty()) return nullptr;
+
+		StdoutSilencer silence;
+		return dictionary_from_file(bench_word_file(10000).string().c_str(), DICT_LOAD_LOWER_ONLY | DICT_LOAD_DONT_ALPHABETIZE);
+	}();
+	return shared;
+}
+
+static void BM_C_ConcurrentContains(benchmark::State& state) {
+	const dict_t* dict = shared_unsorted_dictionary();
+	if (!dict) { state.SkipWithError("No source word list"); return; }
+	static const auto words = bench_words_of_length(5, 256);
+	if (words.empty()) { state.SkipWithError("No 5 letter source words"); return; }
+
+	size_t i = (size_t)state.thread_index() * 97;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(dictionary_contains(dict, words[i++ % words.size()].c_str()));
+	}
+}
+BENCHMARK(BM_C_ConcurrentContains)->ThreadRange(1, 8)->ThreadPerCpu();
+
+static void BM_C_SanitizeToLength(benchmark::State& state) {
+	dict_t* dict = load_dictionary(state);
+	if (!dict) return;
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		dict_t* copy = dictionary_copy(dict);
+		state.ResumeTiming();
+
+		dictionary_sanitize_to_length(copy, (size_t)state.range(1));
+		benchmark::DoNotOptimize(dictionary_word_count(copy));
+
+		state.PauseTiming();
+		dictionary_destroy(copy);
+		state.ResumeTiming();
+	}
+	dictionary_destroy(dict);
+}
+BENCHMARK(BM_C_SanitizeToLength)->Apply(LengthArgs)->Unit(benchmark::kMicrosecond);
+
+static void BM_C_SanitizeToLower(benchmark::State& state) {
+	dict_t* dict = load_dictionary(state);
+	if (!dict) return;
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		dict_t* copy = dictionary_copy(dict);
+		state.ResumeTiming();
+
+		dictionary_sanitize_rough(copy);
+		benchmark::DoNotOptimize(dictionary_word_count(copy));
+
+		state.PauseTiming();
+		dictionary_destroy(copy);
+		state.ResumeTiming();
+	}
+	dictionary_destroy(dict);
+}
+BENCHMARK(BM_C_SanitizeToLower)->Apply(DictionaryArgs)->Unit(benchmark::kMicrosecond);
+
+static void BM_C_BoardFromDictionary(benchmark::State& state) {
+	dict_t* dict = load_dictionary(state);
+	if (!dict) return;
+	const size_t len = (size_t)state.range(1);
+	if (!has_words_of_length(dict, len)) { state.SkipWithError("No words of this length"); dictionary_destroy(dict); return; }
+
+	for (auto _ : state) {
+		board_t* board = wordle_board_new_with_dict(6, dict, len, len);
+		benchmark::DoNotOptimize(board->answer);
+		board_destroy(board);
+	}
+	dictionary_destroy(dict);
+}
+BENCHMARK(BM_C_BoardFromDictionary)->Apply(LengthArgs);
+
+static void BM_C_InsertGuess(benchmark::State& state) {
+	const auto words = bench_words_of_length((size_t)state.range(0), 256);
+	if (words.size() < 2) { state.SkipWithError("No words of this length"); return; }
+
+	StdoutSilencer silence;
+	board_t* board = wordle_board_new_with_answer(255, words[0].c_str());
+	size_t i = 1;
+	for (auto _ : state) {
+		if (board_insert_guess(board, words[i].c_str()) != 0) {
+			state.PauseTiming();
+			board_destroy(board);
+			board = wordle_board_new_with_answer(255, words[0].c_str());
+			state.ResumeTiming();
+		}
+		if (++i == words.size()) i = 1;
+	}
+	board_destroy(board);
+}
+BENCHMARK(BM_C_InsertGuess)->Apply(WordArgs);
+
+static void BM_C_Print(benchmark::State& state) {
+	const auto words = bench_words_of_length((size_t)state.range(0), 8);
+	if (words.size() < 4) { state.SkipWithError("No words of this length"); return; }
+
+	StdoutSilencer silence;
+	board_t* board = wordle_board_new_with_answer(6, words[0].c_str());
+	for (size_t i = 1; i < 4; ++i) board_insert_guess(board, words[i].c_str());
+
+	for (auto _ : state) {
+		board_print(board);
+	}
+	board_destroy(board);
+}
+BENCHMARK(BM_C_Print)->Apply(WordArgs);
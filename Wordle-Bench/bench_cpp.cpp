@@ -0,0 +1,262 @@
+// Hot paths of the C++ front-end. Arguments are { dictionary size },
+// { dictionary size, word length } or { word length }.
+#include "bench_util.hpp"
+
+#include "dictionary.hpp"
+#include "fixed_board.hpp"
+#include "letter_index.hpp"
+#include "thread_rng.hpp"
+#include "word_set.hpp"
+#include "wordle_board.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+static void DictionaryArgs(benchmark::internal::Benchmark* b) {
+	for (int64_t size : { 1000, 10000, 100000 }) b->Args({ size });
+}
+
+static void LengthArgs(benchmark::internal::Benchmark* b) {
+	for (int64_t size : { 1000, 100000 }) {
+		for (int64_t len : { 4, 5, 8 }) b->Args({ size, len });
+	}
+}
+
+static void WordArgs(benchmark::internal::Benchmark* b) {
+	for (int64_t len : { 4, 5, 8 }) b->Args({ len });
+}
+
+static std::unique_ptr<Dictionary> load_dictionary(benchmark::State& state) {
+	if (bench_source_words().empty()) { state.SkipWithError("No source word list"); return nullptr; }
+	return std::make_unique<Dictionary>(bench_word_file((size_t)state.range(0)), Dictionary::LoadFlags::LOWER_ONLY);
+}
+
+static void BM_Cpp_DictionaryLoad(benchmark::State& state) {
+	if (bench_source_words().empty()) { state.SkipWithError("No source word list"); return; }
+	const auto path = bench_word_file((size_t)state.range(0));
+
+	for (auto _ : state) {
+		Dictionary dict(path, Dictionary::LoadFlags::LOWER_ONLY);
+		benchmark::DoNotOptimize(dict.WordCount());
+	}
+}
+BENCHMARK(BM_Cpp_DictionaryLoad)->Apply(DictionaryArgs)->Unit(benchmark::kMicrosecond);
+
+static void BM_Cpp_Contains(benchmark::State& state) {
+	auto dict = load_dictionary(state);
+	if (!dict) return;
+	const auto words = bench_words_of_length((size_t)state.range(1), 256);
+	if (words.empty()) { state.SkipWithError("No words of this length"); return; }
+
+	size_t i = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(dict->Contains(words[i++ % words.size()]));
+	}
+}
+BENCHMARK(BM_Cpp_Contains)->Apply(LengthArgs);
+
+static void BM_Cpp_IndexOf(benchmark::State& state) {
+	auto dict = load_dictionary(state);
+	if (!dict) return;
+	const auto words = bench_words_of_length((size_t)state.range(1), 256);
+	if (words.empty()) { state.SkipWithError("No words of this length"); return; }
+
+	size_t i = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(dict->IndexOf(words[i++ % words.size()]));
+	}
+}
+BENCHMARK(BM_Cpp_IndexOf)->Apply(LengthArgs);
+
+static void BM_Cpp_WordSetContains(benchmark::State& state) {
+	auto dict = load_dictionary(state);
+	if (!dict) return;
+	const WordSet set(dict.get());
+	const auto words = bench_words_of_length((size_t)state.range(1), 256);
+	if (words.empty()) { state.SkipWithError("No words of this length"); return; }
+
+	size_t i = 0;
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(set.Contains(words[i++ % words.size()]));
+	}
+}
+BENCHMARK(BM_Cpp_WordSetContains)->Apply(LengthArgs);
+
+// One dictionary and word set shared by every benchmark thread without
+// locking. Build with -DWORDLE_SANITIZER=thread to check the lookups for
+// races.
+struct SharedLookup {
+	std::unique_ptr<Dictionary> dict;
+	std::unique_ptr<WordSet> set;
+	std::vector<std::string> words;
+};
+
+static const SharedLookup* shared_lookup() {
+	static const std::unique_ptr<SharedLookup> shared = []() -> std::unique_ptr<SharedLookup> {
+		if (bench_source_words().empty()) return nullptr;
+
+		auto lookup = std::make_unique<SharedLookup>();
+		lookup->dict = std::make_unique<Dictionary>(bench_word_file(100000), Dictionary::LoadFlags::LOWER_ONLY);
+		lookup->set = std::make_unique<WordSet>(lookup->dict.get());
+		for (size_t len : { 4, 5, 8 }) {
+			const auto words = bench_words_of_length(len, 256);
+			lookup->words.insert(lookup->words.end(), words.begin(), words.end());
+		}
+		return lookup;
+	}();
+	return shared.get();
+}
+
+static void BM_Cpp_ConcurrentLookup(benchmark::State& state) {
+	const SharedLookup* shared = shared_lookup();
+	if (!shared || shared->words.empty()) { state.SkipWithError("No source word list"); return; }
+
+	const auto& words = shared->words;
+	size_t i = (size_t)state.thread_index() * 97;
+	for (auto _ : state) {
+		const std::string& word = words[i++ % words.size()];
+		benchmark::DoNotOptimize(shared->dict->IndexOf(word));
+		benchmark::DoNotOptimize(shared->set->Contains(word));
+	}
+}
+BENCHMARK(BM_Cpp_ConcurrentLookup)->ThreadRange(1, 8)->ThreadPerCpu();
+
+// Answer draws from one dictionary shared by every thread, each with its own
+// engine. The argument is 1 to weight the words, which samples from the
+// alias tables instead of uniformly.
+static const Dictionary* shared_weighted() {
+	static const std::unique_ptr<Dictionary> dict = []() -> std::unique_ptr<Dictionary> {
+		if (bench_source_words().empty()) return nullptr;
+
+		const auto path = std::filesystem::temp_directory_path() / "wordle_bench_weighted.txt";
+		{
+			const auto& words = bench_source_words();
+			std::ofstream f{ path };
+			for (size_t i = 0; i < 100000 && i < words.size(); ++i) f << words[i] << ' ' << (i * 7919 % 1000 + 1) << '\n';
+		}
+		return std::make_unique<Dictionary>(path, Dictionary::LoadFlags::LOWER_ONLY);
+	}();
+	return dict.get();
+}
+
+static void BM_Cpp_ConcurrentRandomWord(benchmark::State& state) {
+	const SharedLookup* shared = shared_lookup();
+	const Dictionary* dict = state.range(0) ? shared_weighted() : shared ? shared->dict.get() : nullptr;
+	if (!dict) { state.SkipWithError("No source word list"); return; }
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(dict->RandomWord(5, thread_rng()).data());
+	}
+}
+BENCHMARK(BM_Cpp_ConcurrentRandomWord)->Arg(0)->Arg(1)->ThreadRange(1, 8)->ThreadPerCpu();
+
+static void BM_Cpp_SanitizeToLength(benchmark::State& state) {
+	auto dict = load_dictionary(state);
+	if (!dict) return;
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		Dictionary copy(*dict);
+		state.ResumeTiming();
+
+		copy.SanitizeToLength((size_t)state.range(1));
+		benchmark::DoNotOptimize(copy.WordCount());
+	}
+}
+BENCHMARK(BM_Cpp_SanitizeToLength)->Apply(LengthArgs)->Unit(benchmark::kMicrosecond);
+
+// "e" in the middle, no a, at least one r
+static void BM_Cpp_LetterIndexQuery(benchmark::State& state) {
+	auto dict = load_dictionary(state);
+	if (!dict) return;
+	const size_t len = (size_t)state.range(1);
+	const LetterIndex index(dict->WordsOfLength(len));
+
+	std::string pattern(len, '?');
+	pattern[len / 2] = 'e';
+	const auto query = LetterIndex::Query::Parse(pattern + ":a:r");
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(index.Matches(query));
+	}
+}
+BENCHMARK(BM_Cpp_LetterIndexQuery)->Apply(LengthArgs)->Unit(benchmark::kMicrosecond);
+
+static void BM_Cpp_SanitizeToLower(benchmark::State& state) {
+	auto dict = load_dictionary(state);
+	if (!dict) return;
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		Dictionary copy(*dict);
+		state.ResumeTiming();
+
+		copy.SanitizeToLower();
+		benchmark::DoNotOptimize(copy.WordCount());
+	}
+}
+BENCHMARK(BM_Cpp_SanitizeToLower)->Apply(DictionaryArgs)->Unit(benchmark::kMicrosecond);
+
+static void BM_Cpp_BoardFromDictionary(benchmark::State& state) {
+	auto dict = load_dictionary(state);
+	if (!dict) return;
+	const size_t len = (size_t)state.range(1);
+	if (dict->WordsOfLength(len).empty()) { state.SkipWithError("No words of this length"); return; }
+
+	for (auto _ : state) {
+		Board board(6, dict.get(), len, len);
+		benchmark::DoNotOptimize(board.GetAnswer().data());
+	}
+}
+BENCHMARK(BM_Cpp_BoardFromDictionary)->Apply(LengthArgs);
+
+static void BM_Cpp_InsertGuess(benchmark::State& state) {
+	const auto words = bench_words_of_length((size_t)state.range(0), 256);
+	if (words.size() < 2) { state.SkipWithError("No words of this length"); return; }
+
+	auto board = std::make_unique<Board>(255, words[0]);
+	size_t i = 1;
+	for (auto _ : state) {
+		if (board->InsertGuess(words[i]) != 0) {
+			state.PauseTiming();
+			board = std::make_unique<Board>(255, words[0]);
+			state.ResumeTiming();
+		}
+		if (++i == words.size()) i = 1;
+	}
+}
+BENCHMARK(BM_Cpp_InsertGuess)->Apply(WordArgs);
+
+template<size_t N>
+static void BM_Cpp_FixedInsertGuess(benchmark::State& state) {
+	const auto words = bench_words_of_length(N, 256);
+	if (words.size() < 2) { state.SkipWithError("No words of this length"); return; }
+
+	FixedBoard<N> board(255, words[0]);
+	size_t i = 1;
+	for (auto _ : state) {
+		if (board.InsertGuess(words[i]) != 0) board.Reset(words[0]);
+		if (++i == words.size()) i = 1;
+	}
+}
+BENCHMARK_TEMPLATE(BM_Cpp_FixedInsertGuess, 4);
+BENCHMARK_TEMPLATE(BM_Cpp_FixedInsertGuess, 5);
+BENCHMARK_TEMPLATE(BM_Cpp_FixedInsertGuess, 8);
+
+static void BM_Cpp_Print(benchmark::State& state) {
+	const auto words = bench_words_of_length((size_t)state.range(0), 8);
+	if (words.size() < 4) { state.SkipWithError("No words of this length"); return; }
+
+	Board board(6, words[0]);
+	for (size_t i = 1; i < 4; ++i) board.InsertGuess(words[i]);
+
+	StdoutSilencer silence;
+	for (auto _ : state) {
+		board.Print();
+	}
+}
+BENCHMARK(BM_Cpp_Print)->Apply(WordArgs);
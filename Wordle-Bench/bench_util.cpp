@@ -0,0 +1,81 @@
+#include "bench_util.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#define dup _dup
+#define dup2 _dup2
+#define close _close
+#define open _open
+#define NULL_DEVICE "NUL"
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#define NULL_DEVICE "/dev/null"
+#endif
+
+const std::vector<std::string>& bench_source_words() {
+	static const std::vector<std::string> words = [] {
+		const char* env = std::getenv("WORDLE_BENCH_DICT");
+		std::ifstream f{ env ? env : "engmix.txt" };
+
+		std::vector<std::string> out;
+		std::string line;
+		while (std::getline(f, line)) {
+			if (!line.empty() && line.back() == '\r') line.pop_back();
+			if (line.empty()) continue;
+
+			bool lower = true;
+			for (char c : line) if ('a' > c || c > 'z') { lower = false; break; }
+			if (lower) out.push_back(line);
+		}
+		return out;
+	}();
+	return words;
+}
+
+std::filesystem::path bench_word_file(size_t count) {
+	static std::map<size_t, std::filesystem::path> files;
+
+	auto& path = files[count];
+	if (path.empty()) {
+		path = std::filesystem::temp_directory_path() / ("wordle_bench_" + std::to_string(count) + ".txt");
+
+		const auto& words = bench_source_words();
+		std::ofstream f{ path };
+		for (size_t i = 0; i < count && i < words.size(); ++i) f << words[i] << '\n';
+	}
+	return path;
+}
+
+std::vector<std::string> bench_words_of_length(size_t len, size_t count) {
+	std::vector<std::string> out;
+	for (const auto& word : bench_source_words()) {
+		if (out.size() >= count) break;
+		if (word.length() == len) out.push_back(word);
+	}
+	return out;
+}
+
+StdoutSilencer::StdoutSilencer() {
+	std::cout.flush();
+	std::fflush(stdout);
+	saved = dup(1);
+
+	int null = open(NULL_DEVICE, O_WRONLY);
+	dup2(null, 1);
+	close(null);
+}
+
+StdoutSilencer::~StdoutSilencer() {
+	std::cout.flush();
+	std::fflush(stdout);
+	dup2(saved, 1);
+	close(saved);
+}
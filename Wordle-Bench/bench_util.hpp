@@ -0,0 +1,30 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Word list the benchmarks draw from, WORDLE_BENCH_DICT or engmix.txt in the
+// working directory. Only lowercase words are kept.
+const std::vector<std::string>& bench_source_words();
+
+// Text file with the first count source words, written once per count.
+std::filesystem::path bench_word_file(size_t count);
+
+// Source words of exactly len letters, at most count of them.
+std::vector<std::string> bench_words_of_length(size_t len, size_t count);
+
+// Redirects stdout to the null device while alive, so the front-ends' console
+// output doesn't mix with the benchmark report.
+class StdoutSilencer {
+public:
+	StdoutSilencer();
+	~StdoutSilencer();
+
+private:
+	int saved;
+};
+
+#endif
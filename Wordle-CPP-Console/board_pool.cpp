@@ -0,0 +1,57 @@
+#include "board_pool.hpp"
+
+#include <stdexcept>
+#include <string>
+
+BoardPool::BoardPool(uint8_t attempts, size_t wordLen, size_t reserve)
+	: attempts(attempts), wordLen(wordLen) {
+	if (wordLen == 0 || wordLen > Feedback::MaxLength) throw std::invalid_argument("Invalid board length");
+
+	freeList.reserve(reserve);
+	const std::string placeholder(wordLen, 'a');
+	for (size_t i = 0; i < reserve; ++i) {
+		slab.emplace_back(attempts, placeholder);
+		freeList.push_back(&slab.back());
+	}
+}
+
+Board* BoardPool::Take() {
+	if (freeList.empty()) {
+		slab.emplace_back(attempts, std::string(wordLen, 'a'));
+		return &slab.back();
+	}
+	Board* board = freeList.back();
+	freeList.pop_back();
+	return board;
+}
+
+Board* BoardPool::Acquire(std::string_view answer) {
+	if (answer.size() != wordLen) throw std::invalid_argument("Answer length doesn't match the pool");
+
+	Board* board = Take();
+	try {
+		board->Reset(answer);
+	}
+	catch (...) {
+		freeList.push_back(board);
+		throw;
+	}
+	return board;
+}
+
+Board* BoardPool::Acquire(const Dictionary* dict) {
+	Board* board = Take();
+	try {
+		board->Reset(dict, wordLen, wordLen);
+	}
+	catch (...) {
+		freeList.push_back(board);
+		throw;
+	}
+	return board;
+}
+
+void BoardPool::Release(Board* board) {
+	if (!board) return;
+	freeList.push_back(board);
+}
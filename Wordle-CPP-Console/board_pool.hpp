@@ -0,0 +1,44 @@
+#ifndef BOARD_POOL_H
+#define BOARD_POOL_H
+
+#include "wordle_board.hpp"
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <deque>
+#include <string_view>
+#include <vector>
+
+// Hands out boards of one attempts x length shape. Released boards go on a
+// free list and are Reset for the next game, so once the pool is warm games
+// don't touch the heap. Boards live in a deque and never move. Not thread
+// safe, keep one pool per worker thread.
+class BoardPool {
+public:
+	BoardPool(uint8_t attempts, size_t wordLen, size_t reserve = 0);
+	BoardPool(const BoardPool&) = delete;
+	BoardPool& operator=(const BoardPool&) = delete;
+	virtual ~BoardPool() {}
+
+	// answer must be WordLength() letters long
+	Board* Acquire(std::string_view answer);
+	Board* Acquire(const Dictionary* dict);
+	void Release(Board* board);
+
+	size_t Capacity() const { return slab.size(); }
+	size_t Available() const { return freeList.size(); }
+	size_t GetAttempts() const { return attempts; }
+	size_t WordLength() const { return wordLen; }
+
+private:
+	Board* Take();
+
+	uint8_t attempts;
+	size_t wordLen;
+
+	std::deque<Board> slab;
+	std::vector<Board*> freeList;
+};
+
+#endif
@@ -0,0 +1,140 @@
+#include "char_class.hpp"
+
+#include <stdint.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CHAR_CLASS_SSE2
+#include <emmintrin.h>
+#endif
+
+// the AVX2 kernel is compiled with a target attribute and only called after
+// checking the CPU, so the rest of the build doesn't need -mavx2
+#if defined(CHAR_CLASS_SSE2) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CHAR_CLASS_AVX2
+#include <immintrin.h>
+#endif
+
+// Every kernel checks that (c | fold) is in a-z, fold is 0x20 to accept upper
+// case too. When out is set the letters are written to it lowercased. Both
+// SIMD kernels shift a-z to the bottom of the signed byte range, so a single
+// signed compare does the range check.
+typedef bool (*ClassifyFn)(const char* in, char* out, size_t len, char fold);
+
+static bool classify_scalar(const char* in, char* out, size_t len, char fold) {
+	for (size_t i = 0; i < len; ++i) {
+		if ((unsigned char)((in[i] | fold) - 'a') >= 26) return false;
+		if (out) out[i] = in[i] | 0x20;
+	}
+	return true;
+}
+
+#ifdef CHAR_CLASS_SSE2
+static bool classify_sse2(const char* in, char* out, size_t len, char fold) {
+	const __m128i foldMask = _mm_set1_epi8(fold);
+	const __m128i lowerMask = _mm_set1_epi8(0x20);
+	const __m128i shift = _mm_set1_epi8((char)(0x80 - 'a'));
+	const __m128i limit = _mm_set1_epi8((char)(0x80 + 26));
+
+	char tail[16];
+	for (size_t i = 0; i < len; i += 16) {
+		const size_t n = len - i < 16 ? len - i : 16;
+		const char* src = in + i;
+		if (n < 16) {
+			std::memset(tail, 'a', sizeof(tail));
+			std::memcpy(tail, src, n);
+			src = tail;
+		}
+
+		const __m128i c = _mm_loadu_si128((const __m128i*)src);
+		const __m128i shifted = _mm_add_epi8(_mm_or_si128(c, foldMask), shift);
+		if (_mm_movemask_epi8(_mm_cmplt_epi8(shifted, limit)) != 0xFFFF) return false;
+
+		if (out) {
+			const __m128i lower = _mm_or_si128(c, lowerMask);
+			if (n == 16) _mm_storeu_si128((__m128i*)(out + i), lower);
+			else { _mm_storeu_si128((__m128i*)tail, lower); std::memcpy(out + i, tail, n); }
+		}
+	}
+	return true;
+}
+#endif
+
+#ifdef CHAR_CLASS_AVX2
+__attribute__((target("avx2")))
+static bool classify_avx2(const char* in, char* out, size_t len, char fold) {
+	const __m256i foldMask = _mm256_set1_epi8(fold);
+	const __m256i lowerMask = _mm256_set1_epi8(0x20);
+	const __m256i shift = _mm256_set1_epi8((char)(0x80 - 'a'));
+	const __m256i limit = _mm256_set1_epi8((char)(0x80 + 26));
+
+	char tail[32];
+	for (size_t i = 0; i < len; i += 32) {
+		const size_t n = len - i < 32 ? len - i : 32;
+		const char* src = in + i;
+		if (n < 32) {
+			std::memset(tail, 'a', sizeof(tail));
+			std::memcpy(tail, src, n);
+			src = tail;
+		}
+
+		const __m256i c = _mm256_loadu_si256((const __m256i*)src);
+		const __m256i shifted = _mm256_add_epi8(_mm256_or_si256(c, foldMask), shift);
+		// no signed less than in AVX2, limit > shifted instead
+		if ((uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(limit, shifted)) != 0xFFFFFFFFu) return false;
+
+		if (out) {
+			const __m256i lower = _mm256_or_si256(c, lowerMask);
+			if (n == 32) _mm256_storeu_si256((__m256i*)(out + i), lower);
+			else { _mm256_storeu_si256((__m256i*)tail, lower); std::memcpy(out + i, tail, n); }
+		}
+	}
+	return true;
+}
+#endif
+
+struct Kernel {
+	ClassifyFn fn;
+	const char* name;
+};
+
+static Kernel pick_kernel() {
+#ifdef CHAR_CLASS_AVX2
+	__builtin_cpu_init();
+	if (CharClass::SimdAllowed("avx2") && __builtin_cpu_supports("avx2")) return { classify_avx2, "avx2" };
+#endif
+#ifdef CHAR_CLASS_SSE2
+	if (CharClass::SimdAllowed("sse2")) return { classify_sse2, "sse2" };
+#endif
+	return { classify_scalar, "scalar" };
+}
+
+static const Kernel& kernel() {
+	static const Kernel picked = pick_kernel();
+	return picked;
+}
+
+bool CharClass::AllLetters(std::string_view str, bool lowerOnly) {
+	return kernel().fn(str.data(), nullptr, str.size(), lowerOnly ? 0 : 0x20);
+}
+
+bool CharClass::ToLower(char* str, size_t len) {
+	return kernel().fn(str, str, len, 0x20);
+}
+
+const char* CharClass::Implementation() {
+	return kernel().name;
+}
+
+static int _isa_level(const char* isa) {
+	if (std::strcmp(isa, "scalar") == 0) return 0;
+	if (std::strcmp(isa, "sse2") == 0) return 1;
+	return 2;
+}
+
+bool CharClass::SimdAllowed(const char* isa) {
+	const char* cap = std::getenv("WORDLE_SIMD");
+	return !cap || _isa_level(isa) <= _isa_level(cap);
+}
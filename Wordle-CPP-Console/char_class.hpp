@@ -0,0 +1,28 @@
+#ifndef CHAR_CLASS_H
+#define CHAR_CLASS_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Locale independent ASCII letter checks over whole strings. Runs 32 bytes
+// at a time with AVX2 or 16 with SSE2, picked once at runtime, and falls back
+// to a scalar loop elsewhere.
+class CharClass {
+public:
+	// True if every byte is an ASCII letter, only a-z when lowerOnly is set
+	static bool AllLetters(std::string_view str, bool lowerOnly = false);
+	// Lowercases str in place and returns true if it's all ASCII letters,
+	// otherwise returns false and str may be partly lowercased
+	static bool ToLower(char* str, size_t len);
+	static bool ToLower(std::string& str) { return ToLower(str.data(), str.size()); }
+
+	// "avx2", "sse2" or "scalar"
+	static const char* Implementation();
+
+	// False when the WORDLE_SIMD environment variable, "scalar" or "sse2",
+	// rules out kernels using isa. Lets the tests run every kernel on one CPU.
+	static bool SimdAllowed(const char* isa);
+};
+
+#endif
@@ -0,0 +1,115 @@
+#include "constraints.hpp"
+
+#include <stdexcept>
+
+#define ALL_LETTERS ((1u << 26) - 1)
+
+Constraints::Constraints(Dictionary::WordRange words)
+	: words(words), wordLen(words.empty() ? 0 : words[0].length()) {
+	if (wordLen > Feedback::MaxLength) throw std::invalid_argument("Word length is too long for constraints");
+	Reset();
+}
+
+void Constraints::Reset() {
+	allowed.fill(ALL_LETTERS);
+	minCount.fill(0);
+	maxCount.fill((uint8_t)wordLen);
+	required = 0;
+	counted.clear();
+	candidates.assign(words.begin(), words.end());
+}
+
+void Constraints::Update(std::string_view guess, uint32_t pattern) {
+	if (guess.length() != wordLen) throw std::invalid_argument("Guess length doesn't match the constraints");
+
+	std::array<uint8_t, 26> hits{};
+	uint32_t missed = 0;
+	for (size_t i = 0; i < wordLen; ++i) {
+		const unsigned letter = (unsigned char)guess[i] - 'a';
+		if (letter >= 26) throw std::invalid_argument("Guess must be lowercase letters");
+
+		if (Feedback::At(pattern, i) == Feedback::Green) {
+			allowed[i] = 1u << letter;
+		} else {
+			allowed[i] &= ~(1u << letter);
+		}
+
+		if (Feedback::At(pattern, i) == Feedback::Grey) missed |= 1u << letter;
+		else hits[letter]++;
+	}
+
+	// greens and yellows give a lower bound, a grey copy of the same letter
+	// makes it exact
+	for (unsigned letter = 0; letter < 26; ++letter) {
+		if (hits[letter] > minCount[letter]) minCount[letter] = hits[letter];
+		if ((missed >> letter & 1) && hits[letter] < maxCount[letter]) maxCount[letter] = hits[letter];
+	}
+
+	required = 0;
+	counted.clear();
+	uint32_t absent = 0;
+	for (uint8_t letter = 0; letter < 26; ++letter) {
+		if (minCount[letter]) required |= 1u << letter;
+		if (maxCount[letter] == 0) absent |= 1u << letter;
+		else if (minCount[letter] > 1 || maxCount[letter] < wordLen) counted.push_back(letter);
+	}
+	for (size_t i = 0; i < wordLen; ++i) allowed[i] &= ~absent;
+
+	size_t kept = 0;
+	for (const auto& word : candidates) {
+		if (Allows(word)) candidates[kept++] = word;
+	}
+	candidates.resize(kept);
+}
+
+bool Constraints::Allows(std::string_view word) const {
+	if (word.length() != wordLen) return false;
+
+	std::array<uint8_t, 26> counts{};
+	uint32_t present = 0;
+	for (size_t i = 0; i < wordLen; ++i) {
+		const unsigned letter = (unsigned char)word[i] - 'a';
+		if (letter >= 26 || !(allowed[i] >> letter & 1)) return false;
+		present |= 1u << letter;
+		counts[letter]++;
+	}
+	if ((present & required) != required) return false;
+
+	for (uint8_t letter : counted) {
+		if (counts[letter] < minCount[letter] || counts[letter] > maxCount[letter]) return false;
+	}
+	return true;
+}
+
+std::string Constraints::Violation(std::string_view word) const {
+	if (word.length() != wordLen) return "Guess must be " + std::to_string(wordLen) + " letters long";
+
+	std::array<uint8_t, 26> counts{};
+	for (size_t i = 0; i < wordLen; ++i) {
+		const unsigned letter = (unsigned char)word[i] - 'a';
+		if (letter >= 26) return "Guess must be lowercase letters";
+		counts[letter]++;
+
+		if (allowed[i] >> letter & 1) continue;
+		const std::string position = "Letter " + std::to_string(i + 1);
+		if ((allowed[i] & (allowed[i] - 1)) == 0) {
+			for (char c = 'a'; c <= 'z'; ++c) {
+				if (allowed[i] == 1u << (c - 'a')) return position + " must be " + (char)(c - 'a' + 'A');
+			}
+		}
+		return position + " can't be " + (char)(letter + 'A');
+	}
+
+	for (uint8_t letter = 0; letter < 26; ++letter) {
+		const std::string name(1, (char)(letter + 'A'));
+		if (counts[letter] < minCount[letter]) {
+			if (minCount[letter] == 1) return "Guess must contain " + name;
+			return "Guess must contain " + std::to_string(minCount[letter]) + " " + name + "s";
+		}
+		if (counts[letter] > maxCount[letter]) {
+			if (maxCount[letter] == 0) return "Guess can't contain " + name;
+			return "Guess can't contain more than " + std::to_string(maxCount[letter]) + " " + name + (maxCount[letter] > 1 ? "s" : "");
+		}
+	}
+	return std::string();
+}
@@ -0,0 +1,48 @@
+#ifndef CONSTRAINTS_H
+#define CONSTRAINTS_H
+
+#include "dictionary.hpp"
+#include "feedback.hpp"
+
+#include <stdint.h>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Everything the feedback so far says about the answer: a 26 bit mask of the
+// letters still allowed at each position, and bounds on how often each letter
+// appears. A word satisfies the constraints exactly when it would have
+// produced every pattern seen, which is also the hard mode rule for guesses.
+// The candidate answers shrink in place with every Update.
+class Constraints {
+public:
+	Constraints(Dictionary::WordRange words);
+	virtual ~Constraints() {}
+
+	void Reset();
+	void Update(std::string_view guess, uint32_t pattern);
+
+	bool Allows(std::string_view word) const;
+	// Why word breaks the constraints, empty when it doesn't
+	std::string Violation(std::string_view word) const;
+
+	const std::vector<std::string_view>& GetCandidates() const { return candidates; }
+	size_t WordLength() const { return wordLen; }
+
+private:
+	Dictionary::WordRange words;
+	size_t wordLen;
+
+	std::array<uint32_t, Feedback::MaxLength> allowed;
+	std::array<uint8_t, 26> minCount, maxCount;
+	// letters that have to appear somewhere
+	uint32_t required;
+	// letters with count bounds a presence check doesn't cover
+	std::vector<uint8_t> counted;
+
+	std::vector<std::string_view> candidates;
+};
+
+#endif
@@ -0,0 +1,119 @@
+#include "daily_schedule.hpp"
+#include "mapped_file.hpp"
+#include "word_hash.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define SCHEDULE_MAGIC "WSCH"
+#define SCHEDULE_VERSION 1
+
+struct ScheduleHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t wordLength;
+	uint32_t reserved;
+	uint64_t seed;
+	uint64_t count;
+	uint64_t hash;
+	int64_t startDay;
+};
+
+// Uniform in [0, range) by Lemire's multiply and reject, which unlike
+// std::uniform_int_distribution is the same on every standard library
+static uint32_t _bounded(std::mt19937_64& rng, uint32_t range) {
+	uint64_t m = (rng() >> 32) * range;
+	uint32_t low = (uint32_t)m;
+	if (low < range) {
+		const uint32_t threshold = (uint32_t)-range % range;
+		while (low < threshold) {
+			m = (rng() >> 32) * range;
+			low = (uint32_t)m;
+		}
+	}
+	return (uint32_t)(m >> 32);
+}
+
+DailySchedule::DailySchedule(Dictionary::WordRange words, uint64_t seed, int64_t startDay)
+	: data(nullptr), count(words.size()), wordLen(words.empty() ? 0 : words[0].length()), seed(seed), startDay(startDay) {
+	if (count == 0 || wordLen == 0) throw std::invalid_argument("No words to schedule");
+	if (count > UINT32_MAX) throw std::invalid_argument("Too many words to schedule");
+	hash = HashWords(words);
+
+	// Fisher-Yates over word indexes
+	std::vector<uint32_t> order(count);
+	for (size_t i = 0; i < count; ++i) order[i] = (uint32_t)i;
+	std::mt19937_64 rng(seed);
+	for (size_t i = count - 1; i > 0; --i) std::swap(order[i], order[_bounded(rng, (uint32_t)i + 1)]);
+
+	auto shuffled = std::make_shared<std::string>();
+	shuffled->reserve(count * wordLen);
+	for (uint32_t i : order) shuffled->append(words[i]);
+
+	data = shuffled->data();
+	storage = shuffled;
+}
+
+DailySchedule::DailySchedule(const std::filesystem::path& filepath) {
+	auto file = std::make_shared<MappedFile>(filepath);
+	if (file->Size() < sizeof(ScheduleHeader)) throw std::runtime_error("Invalid schedule file");
+
+	ScheduleHeader header;
+	std::memcpy(&header, file->Data(), sizeof(header));
+	if (std::memcmp(header.magic, SCHEDULE_MAGIC, 4) != 0) throw std::runtime_error("Invalid schedule file");
+	if (header.version != SCHEDULE_VERSION) throw std::runtime_error("Unsupported schedule version");
+	if (header.count == 0 || header.wordLength == 0 || (file->Size() - sizeof(ScheduleHeader)) / header.wordLength < header.count) {
+		throw std::runtime_error("Truncated schedule file");
+	}
+
+	count = (size_t)header.count;
+	wordLen = header.wordLength;
+	seed = header.seed;
+	hash = header.hash;
+	startDay = header.startDay;
+	data = file->Data() + sizeof(ScheduleHeader);
+	storage = file;
+}
+
+void DailySchedule::Save(const std::filesystem::path& outpath) const {
+	ScheduleHeader header;
+	std::memcpy(header.magic, SCHEDULE_MAGIC, 4);
+	header.version = SCHEDULE_VERSION;
+	header.wordLength = (uint32_t)wordLen;
+	header.reserved = 0;
+	header.seed = seed;
+	header.count = count;
+	header.hash = hash;
+	header.startDay = startDay;
+
+	std::ofstream f{ outpath, std::ios::binary | std::ios::trunc };
+	if (!f.is_open()) throw std::runtime_error("Failed to open file!");
+
+	f.write((const char*)&header, sizeof(header));
+	f.write(data, count * wordLen);
+	if (!f) throw std::runtime_error("Failed to write file!");
+}
+
+std::string_view DailySchedule::AnswerForDay(int64_t day) const {
+	if (day < startDay) throw std::out_of_range("The schedule starts after day " + std::to_string(day));
+	return (*this)[(uint64_t)(day - startDay) % count];
+}
+
+int64_t DailySchedule::Today() {
+	// system_clock counts from the Unix epoch without leap seconds, so this
+	// rolls over at midnight UTC
+	const auto now = std::chrono::system_clock::now().time_since_epoch();
+	return std::chrono::duration_cast<std::chrono::seconds>(now).count() / 86400;
+}
+
+uint64_t DailySchedule::HashWords(Dictionary::WordRange words) {
+	WordHash h;
+	h.Add(words);
+	return h.Value();
+}
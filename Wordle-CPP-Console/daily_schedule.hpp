@@ -0,0 +1,53 @@
+#ifndef DAILY_SCHEDULE_H
+#define DAILY_SCHEDULE_H
+
+#include "dictionary.hpp"
+
+#include <stdint.h>
+
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+// Answers of the daily puzzle, a seeded shuffle of a length bucket so no word
+// repeats until all of them have been played. Saved files are mapped and
+// looked up by day without touching the dictionary, which makes serving the
+// daily answer a table lookup.
+//
+// The shuffle only uses std::mt19937_64, whose output the standard fixes, so
+// a seed gives the same schedule with every compiler and standard library.
+class DailySchedule {
+public:
+	// Shuffles words with seed, starting the schedule on startDay
+	DailySchedule(Dictionary::WordRange words, uint64_t seed, int64_t startDay);
+	// Maps a schedule written by Save
+	DailySchedule(const std::filesystem::path& filepath);
+	virtual ~DailySchedule() {}
+
+	void Save(const std::filesystem::path& outpath) const;
+
+	// Answer for a day counted like Today(). Once every word has been played
+	// the schedule starts over.
+	std::string_view AnswerForDay(int64_t day) const;
+	std::string_view operator[](size_t idx) const { return std::string_view(data + idx * wordLen, wordLen); }
+
+	size_t Count() const { return count; }
+	size_t WordLength() const { return wordLen; }
+	uint64_t Seed() const { return seed; }
+	int64_t StartDay() const { return startDay; }
+	// HashWords of the bucket the schedule was shuffled from
+	uint64_t Hash() const { return hash; }
+
+	// Days since 1970-01-01 in UTC, so every server agrees on the puzzle
+	static int64_t Today();
+	static uint64_t HashWords(Dictionary::WordRange words);
+
+private:
+	std::shared_ptr<const void> storage;
+	const char* data;
+	size_t count, wordLen;
+	uint64_t seed, hash;
+	int64_t startDay;
+};
+
+#endif
@@ -1,11 +1,65 @@
 #include "dictionary.hpp"
+#include "char_class.hpp"
+#include "mapped_file.hpp"
+#include "static_dictionary.hpp"
+#include "thread_pool.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
 #define TMP_BUF_LENGTH 0x1000
 
+#define DICTIONARY_MAGIC "WDCT"
+#define DICTIONARY_VERSION 2
+#define DICTIONARY_FLAG_ALPHABETIZED (0b1 << 0)
+#define DICTIONARY_FLAG_WEIGHTED (0b1 << 1)
+
+// Compiled dictionary layout, native byte order:
+//   FileHeader
+//   BucketEntry[maxLength + 1], indexed by word length
+//   per bucket, count words of exactly that length with no separators
+//   with DICTIONARY_FLAG_WEIGHTED, zero padding to 8 bytes and a double
+//   weight per word in the same order (version 2)
+struct FileHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t flags;
+	uint32_t maxLength;
+	uint64_t wordCount;
+};
+
+struct BucketEntry {
+	uint64_t offset;
+	uint64_t count;
+};
+
+static_assert(sizeof(FileHeader) == StaticDictionary::HeaderSize && sizeof(BucketEntry) == StaticDictionary::BucketSize, "StaticDictionary writes a different layout");
+static_assert(DICTIONARY_VERSION == StaticDictionary::Version && DICTIONARY_FLAG_ALPHABETIZED == StaticDictionary::FlagAlphabetized, "StaticDictionary writes a different header");
+
+static bool _length_order(std::string_view a, std::string_view b) {
+	return a.length() < b.length();
+}
+
+// True if column, the rest of a line after its word, is whitespace and a
+// number with nothing but whitespace after it
+static bool _parse_weight(std::string_view column, double& weight) {
+	// the text isn't null terminated, strtod gets a copy of the column
+	char copy[64];
+	if (column.length() >= sizeof(copy)) return false;
+	std::memcpy(copy, column.data(), column.length());
+	copy[column.length()] = '\0';
+
+	char* end;
+	weight = strtod(copy, &end);
+	if (end == copy) return false;
+	while (*end == ' ' || *end == '\t' || *end == '\r') end++;
+	return *end == '\0';
+}
+
 /*
 #include <cstdio>
 #include <cstdlib>
@@ -313,40 +367,368 @@ void dictionary_sanitize_to_length(dict_t* dict, size_t length) {
 }
 */
 
-Dictionary::Dictionary(const std::filesystem::path& filepath, LoadFlags flags)
+Dictionary::Dictionary(const std::filesystem::path& filepath, LoadFlags flags, size_t length)
 	: alphabetized(false)
 {
 	if (!std::filesystem::exists(filepath)) throw std::runtime_error("No file at specified path");
 
-	std::ifstream f{ filepath };
-	if (!f.is_open()) throw std::runtime_error("Failed to open file!");
+	auto file = std::make_shared<MappedFile>(filepath);
+	storage = file;
 
-	std::string tmp;
-	while (!f.eof()) {
-		std::getline(f, tmp);
+	if (file->Size() >= sizeof(FileHeader) && std::memcmp(file->Data(), DICTIONARY_MAGIC, 4) == 0) {
+		LoadCompiled(file->Data(), file->Size());
+		if (length) SanitizeToLength(length);
+		return;
+	}
 
-		bool valid = true;
-		for (const auto& ch : tmp) {
-			if ((uint32_t)flags & (uint32_t)LoadFlags::LOWER_ONLY && ('a' > ch || ch > 'z')) { valid = false; break; }
-			else if (!std::isalpha(ch)) { valid = false; break; }
+	const bool alphabetize = !((uint32_t)flags & (uint32_t)LoadFlags::DONT_ALPHABETIZE);
+	const char* data = file->Data();
+	const size_t size = file->Size();
+
+	if (size < ParallelLoadSize) {
+		LoadChunk(data, data + size, flags, length, dictionary);
+		SortChunk(dictionary.begin(), dictionary.end(), alphabetize);
+	} else {
+		ThreadPool pool;
+
+		// newline aligned chunks, a few per thread so uneven lines balance out
+		const size_t chunkCount = std::min(pool.ThreadCount() * 4, size / (ParallelLoadSize / 4));
+		std::vector<const char*> bounds{ data };
+		for (size_t i = 1; i < chunkCount; ++i) {
+			const char* split = std::max(data + size * i / chunkCount, bounds.back());
+			const char* eol = (const char*)std::memchr(split, '\n', data + size - split);
+			if (!eol) break;
+			bounds.push_back(eol + 1);
+		}
+		bounds.push_back(data + size);
+
+		std::vector<std::vector<std::string_view>> chunks(bounds.size() - 1);
+		pool.ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end, size_t) {
+			for (size_t i = begin; i < end; ++i) {
+				LoadChunk(bounds[i], bounds[i + 1], flags, length, chunks[i]);
+				SortChunk(chunks[i].begin(), chunks[i].end(), alphabetize);
+			}
+			});
+
+		std::vector<size_t> runs{ 0 };
+		for (const auto& chunk : chunks) runs.push_back(runs.back() + chunk.size());
+		dictionary.resize(runs.back());
+		pool.ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end, size_t) {
+			for (size_t i = begin; i < end; ++i) {
+				std::copy(chunks[i].begin(), chunks[i].end(), dictionary.begin() + runs[i]);
+				std::vector<std::string_view>().swap(chunks[i]);
+			}
+			});
+
+		// merge neighbouring runs pairwise, inplace_merge is stable so file
+		// order survives for DONT_ALPHABETIZE and between duplicates
+		while (runs.size() > 2) {
+			const size_t pairs = (runs.size() - 1) / 2;
+			pool.ParallelFor(pairs, 1, [&](size_t begin, size_t end, size_t) {
+				for (size_t i = begin; i < end; ++i) {
+					const auto first = dictionary.begin() + runs[i * 2];
+					const auto middle = dictionary.begin() + runs[i * 2 + 1];
+					const auto last = dictionary.begin() + runs[i * 2 + 2];
+					if (alphabetize) std::inplace_merge(first, middle, last, WordOrder);
+					else std::inplace_merge(first, middle, last, _length_order);
+				}
+				});
+
+			std::vector<size_t> merged;
+			for (size_t i = 0; i < runs.size(); i += 2) merged.push_back(runs[i]);
+			if (merged.back() != runs.back()) merged.push_back(runs.back());
+			runs.swap(merged);
+		}
+	}
+
+	if (alphabetize) {
+		dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+		alphabetized = true;
+	}
+	LoadWeights(data, data + size);
+	BuildBuckets();
+	dictionary.shrink_to_fit();
+}
+
+Dictionary::Dictionary(const std::vector<std::string>& list, LoadFlags flags)
+	: alphabetized(false)
+{
+	// one newline separated copy the views point into, loaded like a file
+	auto text = std::make_shared<std::string>();
+	size_t size = 0;
+	for (const auto& word : list) size += word.length() + 1;
+	text->reserve(size);
+	for (const auto& word : list) {
+		text->append(word);
+		text->push_back('\n');
+	}
+	storage = text;
+
+	const bool alphabetize = !((uint32_t)flags & (uint32_t)LoadFlags::DONT_ALPHABETIZE);
+	LoadChunk(text->data(), text->data() + text->size(), flags, 0, dictionary);
+	SortChunk(dictionary.begin(), dictionary.end(), alphabetize);
+
+	if (alphabetize) {
+		dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+		alphabetized = true;
+	}
+	LoadWeights(text->data(), text->data() + text->size());
+	BuildBuckets();
+	dictionary.shrink_to_fit();
+}
+
+Dictionary::Dictionary(const void* data, size_t size)
+	: alphabetized(false)
+{
+	if (size < sizeof(FileHeader) || std::memcmp(data, DICTIONARY_MAGIC, 4) != 0) throw std::runtime_error("Not a compiled dictionary");
+	LoadCompiled((const char*)data, size);
+}
+
+void Dictionary::LoadChunk(const char* buf, const char* end, LoadFlags flags, size_t length, std::vector<std::string_view>& out) {
+	const bool lowerOnly = (uint32_t)flags & (uint32_t)LoadFlags::LOWER_ONLY;
+	out.reserve(std::count(buf, end, '\n') + 1);
+
+	while (buf < end) {
+		const char* eol = (const char*)std::memchr(buf, '\n', end - buf);
+		if (!eol) eol = end;
+
+		std::string_view line(buf, eol - buf);
+		if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+		buf = eol + 1;
+
+		// a weight column is parsed once the words are final, anything else
+		// after a space makes the line invalid like before
+		const size_t space = line.find_first_of(" \t");
+		double weight;
+		if (space != std::string_view::npos && _parse_weight(line.substr(space), weight)) line = line.substr(0, space);
+
+		if (line.empty() || (length && line.length() != length)) continue;
+
+		if (CharClass::AllLetters(line, lowerOnly)) out.push_back(line);
+	}
+}
+
+void Dictionary::SortChunk(std::vector<std::string_view>::iterator first, std::vector<std::string_view>::iterator last, bool alphabetize) {
+	if (alphabetize) {
+		// equal words stay in file order, so deduplicating keeps the first
+		// copy and its weight on every load path
+		std::sort(first, last, [](std::string_view a, std::string_view b) {
+			if (a != b) return WordOrder(a, b);
+			return a.data() < b.data();
+			});
+	} else {
+		std::stable_sort(first, last, _length_order);
+	}
+}
+
+void Dictionary::LoadCompiled(const char* data, size_t size) {
+	FileHeader header;
+	std::memcpy(&header, data, sizeof(header));
+	if (header.version < 1 || header.version > DICTIONARY_VERSION) throw std::runtime_error("Unsupported compiled dictionary version");
+
+	// sizes come from the file, so every check divides instead of multiplying
+	// where a corrupt value could overflow
+	if ((size - sizeof(FileHeader)) / sizeof(BucketEntry) <= header.maxLength) throw std::runtime_error("Truncated compiled dictionary");
+	const size_t tableEnd = sizeof(FileHeader) + ((size_t)header.maxLength + 1) * sizeof(BucketEntry);
+
+	std::vector<BucketEntry> table((size_t)header.maxLength + 1);
+	std::memcpy(table.data(), data + sizeof(FileHeader), table.size() * sizeof(BucketEntry));
+	uint64_t wordCount = 0;
+	size_t wordsEnd = tableEnd;
+	for (size_t len = 0; len < table.size(); ++len) {
+		const BucketEntry& bucket = table[len];
+		if (bucket.count == 0) continue;
+		// buckets are packed in length order, so words can't outnumber bytes
+		if (len == 0 || bucket.offset < wordsEnd) throw std::runtime_error("Corrupt compiled dictionary");
+		if (bucket.offset > size || bucket.count > (size - bucket.offset) / len) throw std::runtime_error("Truncated compiled dictionary");
+
+		wordCount += bucket.count;
+		wordsEnd = bucket.offset + bucket.count * len;
+	}
+	if (wordCount != header.wordCount) throw std::runtime_error("Corrupt compiled dictionary");
+
+	dictionary.reserve(wordCount);
+	for (size_t len = 1; len < table.size(); ++len) {
+		const char* word = data + table[len].offset;
+		for (size_t i = 0; i < table[len].count; ++i, word += len) {
+			dictionary.emplace_back(word, len);
+		}
+	}
+
+	if (header.flags & DICTIONARY_FLAG_WEIGHTED) {
+		const size_t weightsStart = wordsEnd + WeightPadding(wordsEnd - tableEnd);
+		if (weightsStart > size || (size - weightsStart) / sizeof(double) < dictionary.size()) throw std::runtime_error("Truncated compiled dictionary");
+		weights.resize(dictionary.size());
+		std::memcpy(weights.data(), data + weightsStart, weights.size() * sizeof(double));
+	}
+
+	alphabetized = header.flags & DICTIONARY_FLAG_ALPHABETIZED;
+	BuildBuckets();
+}
+
+void Dictionary::LoadWeights(const char* begin, const char* end) {
+	bool weighted = false;
+	std::vector<double> parsed(dictionary.size(), 1.0);
+	for (size_t i = 0; i < dictionary.size(); ++i) {
+		const char* pos = dictionary[i].data() + dictionary[i].length();
+		if (pos < begin || pos >= end || (*pos != ' ' && *pos != '\t')) continue;
+
+		const char* eol = (const char*)std::memchr(pos, '\n', end - pos);
+		double weight;
+		if (!_parse_weight(std::string_view(pos, (eol ? eol : end) - pos), weight)) continue;
+		if (!(weight >= 0.0) || weight == HUGE_VAL) throw std::runtime_error("Invalid word weight");
+		parsed[i] = weight;
+		weighted = true;
+	}
+
+	if (weighted) weights.swap(parsed);
+}
+
+void Dictionary::RemoveWords(bool (*remove)(std::string_view word, size_t length), size_t length) {
+	size_t out = 0;
+	for (size_t i = 0; i < dictionary.size(); ++i) {
+		if (remove(dictionary[i], length)) continue;
+		dictionary[out] = dictionary[i];
+		if (!weights.empty()) weights[out] = weights[i];
+		out++;
+	}
+
+	dictionary.resize(out);
+	dictionary.shrink_to_fit();
+	if (!weights.empty()) {
+		weights.resize(out);
+		weights.shrink_to_fit();
+	}
+	BuildBuckets();
+}
+
+void Dictionary::BuildBuckets() {
+	buckets.clear();
+	for (size_t i = 0; i < dictionary.size(); ++i) {
+		size_t len = dictionary[i].length();
+		if (len >= buckets.size()) buckets.resize(len + 1, { i, 0 });
+		buckets[len].second++;
+	}
+
+	aliases.clear();
+	if (weights.empty()) return;
+
+	aliases.resize(buckets.size());
+	std::vector<double> scaled;
+	std::vector<uint32_t> small, large;
+	for (size_t len = 0; len < buckets.size(); ++len) {
+		const auto [first, count] = buckets[len];
+		double total = 0.0;
+		for (size_t i = first; i < first + count; ++i) total += weights[i];
+		if (count == 0 || !(total > 0.0)) continue;
+
+		// scale to an average of 1, then pair every slot under 1 with one
+		// over 1 that tops it up
+		auto& table = aliases[len];
+		table.probability.assign(count, 1.0);
+		table.alias.resize(count);
+		scaled.resize(count);
+		small.clear();
+		large.clear();
+		for (size_t i = 0; i < count; ++i) {
+			table.alias[i] = (uint32_t)i;
+			scaled[i] = weights[first + i] * count / total;
+			(scaled[i] < 1.0 ? small : large).push_back((uint32_t)i);
 		}
 
-		if (valid) dictionary.push_back(tmp);
+		while (!small.empty() && !large.empty()) {
+			const uint32_t less = small.back(), more = large.back();
+			small.pop_back();
+			table.probability[less] = scaled[less];
+			table.alias[less] = more;
+
+			scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+			if (scaled[more] < 1.0) {
+				large.pop_back();
+				small.push_back(more);
+			}
+		}
+		// whatever is left is 1 up to rounding, those slots keep themselves
+	}
+}
+
+const double* Dictionary::WeightsOfLength(size_t len) const {
+	if (weights.empty() || len >= buckets.size()) return nullptr;
+	return weights.data() + buckets[len].first;
+}
+
+Dictionary::WordRange Dictionary::WordsOfLength(size_t len) const {
+	if (len >= buckets.size()) return { dictionary.data(), 0 };
+	return { dictionary.data() + buckets[len].first, buckets[len].second };
+}
+
+void Dictionary::Save(const std::filesystem::path& outpath) const {
+	const std::string data = Serialize();
+
+	std::ofstream f{ outpath, std::ios::binary | std::ios::trunc };
+	if (!f.is_open()) throw std::runtime_error("Failed to open file!");
+
+	f.write(data.data(), data.size());
+	if (!f) throw std::runtime_error("Failed to write file!");
+}
+
+std::string Dictionary::Serialize() const {
+	std::vector<uint64_t> lengthCounts(buckets.size());
+	for (size_t len = 0; len < buckets.size(); ++len) lengthCounts[len] = buckets[len].second;
+
+	std::string out = CompiledHeader(lengthCounts, alphabetized, !weights.empty());
+	size_t wordBytes = 0;
+	for (const auto& word : dictionary) wordBytes += word.length();
+	out.reserve(out.size() + wordBytes + WeightPadding(wordBytes) + weights.size() * sizeof(double));
+	for (const auto& word : dictionary) {
+		out.append(word.data(), word.length());
+	}
+
+	if (!weights.empty()) {
+		out.append(WeightPadding(wordBytes), '\0');
+		out.append((const char*)weights.data(), weights.size() * sizeof(double));
+	}
+	return out;
+}
+
+std::string Dictionary::CompiledHeader(const std::vector<uint64_t>& lengthCounts, bool alphabetized, bool weighted) {
+	size_t maxLength = lengthCounts.empty() ? 0 : lengthCounts.size() - 1;
+	std::vector<BucketEntry> buckets(maxLength + 1, BucketEntry{ 0, 0 });
+	uint64_t offset = sizeof(FileHeader) + buckets.size() * sizeof(BucketEntry);
+	uint64_t wordCount = 0;
+	for (size_t len = 0; len < lengthCounts.size(); ++len) {
+		if (lengthCounts[len] == 0) continue;
+		buckets[len] = { offset, lengthCounts[len] };
+		offset += lengthCounts[len] * len;
+		wordCount += lengthCounts[len];
 	}
 
-	f.close();
+	FileHeader header;
+	std::memcpy(header.magic, DICTIONARY_MAGIC, 4);
+	header.version = DICTIONARY_VERSION;
+	header.flags = (alphabetized ? DICTIONARY_FLAG_ALPHABETIZED : 0) | (weighted ? DICTIONARY_FLAG_WEIGHTED : 0);
+	header.maxLength = (uint32_t)maxLength;
+	header.wordCount = wordCount;
+
+	std::string out;
+	out.append((const char*)&header, sizeof(header));
+	out.append((const char*)buckets.data(), buckets.size() * sizeof(BucketEntry));
+	return out;
 }
 
-bool Dictionary::Contains(const std::string& str) {
+bool Dictionary::Contains(std::string_view str) const {
 	return IndexOf(str).has_value();
 }
 
-std::optional<size_t> Dictionary::IndexOf(const std::string& str) {
-	const auto& iter = std::find_if(dictionary.cbegin(), dictionary.cend(), [str](const std::string& a) {
-		return a == str;
-		});
+std::optional<size_t> Dictionary::IndexOf(std::string_view str) const {
+	if (!alphabetized) {
+		const auto& iter = std::find(dictionary.cbegin(), dictionary.cend(), str);
+		if (iter == dictionary.cend()) return std::nullopt;
+		return iter - dictionary.cbegin();
+	}
 
-	if (iter == dictionary.cend()) return std::nullopt;
+	const auto& iter = std::lower_bound(dictionary.cbegin(), dictionary.cend(), str, WordOrder);
+	if (iter == dictionary.cend() || *iter != str) return std::nullopt;
 
 	return iter - dictionary.cbegin();
 }
@@ -359,20 +741,36 @@ void Dictionary::PrintSublist(size_t offset, size_t count) const {
 	}
 }
 
-void Dictionary::SanitizeToLower() {
-	const auto& end = std::remove_if(dictionary.begin(), dictionary.end(), [](const std::string& a) {
-		return std::find_if(a.begin(), a.end(), [](char c) { return !std::islower(c); }) != a.end();
-		});
+void Dictionary::Alphabetize() {
+	if (weights.empty()) {
+		std::sort(dictionary.begin(), dictionary.end(), WordOrder);
+		dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+	} else {
+		// weights move with their words, duplicates keep the first weight
+		std::vector<std::pair<std::string_view, double>> weighted(dictionary.size());
+		for (size_t i = 0; i < dictionary.size(); ++i) weighted[i] = { dictionary[i], weights[i] };
+		std::stable_sort(weighted.begin(), weighted.end(), [](const auto& a, const auto& b) { return WordOrder(a.first, b.first); });
+		weighted.erase(std::unique(weighted.begin(), weighted.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), weighted.end());
+
+		dictionary.resize(weighted.size());
+		weights.resize(weighted.size());
+		for (size_t i = 0; i < weighted.size(); ++i) {
+			dictionary[i] = weighted[i].first;
+			weights[i] = weighted[i].second;
+		}
+	}
+	alphabetized = true;
+	BuildBuckets();
+}
 
-	dictionary.erase(end, dictionary.end());
-	dictionary.shrink_to_fit();
+void Dictionary::SanitizeToLower() {
+	RemoveWords([](std::string_view a, size_t) {
+		return !CharClass::AllLetters(a, true);
+		}, 0);
 }
 
 void Dictionary::SanitizeToLength(size_t length) {
-	const auto& end = std::remove_if(dictionary.begin(), dictionary.end(), [length](const std::string& a) {
+	RemoveWords([](std::string_view a, size_t length) {
 		return a.length() != length;
-		});
-
-	dictionary.erase(end, dictionary.end());
-	dictionary.shrink_to_fit();
+		}, length);
 }
@@ -4,8 +4,12 @@
 #include <stdint.h>
 
 #include <filesystem>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <optional>
+#include <random>
+#include <stdexcept>
 #include <vector>
 
 /*typedef struct _dict_struct {
@@ -38,26 +42,80 @@ void dictionary_alphabetize(dict_t* dict);
 void dictionary_sanitize_rough(dict_t* dict);
 void dictionary_sanitize_to_length(dict_t* dict, size_t length);*/
 
+// Everything is built while loading, so the const members never modify the
+// dictionary and can be called from any number of threads without locking.
 class Dictionary {
 public:
+	static constexpr size_t ParallelLoadSize = 1 << 20;
+
 	enum class LoadFlags : uint32_t {
 		NONE = (0b0),
 		DONT_ALPHABETIZE = (0b1 << 0),
 		LOWER_ONLY = (0b1 << 1),
 	};
 
-	Dictionary(const std::filesystem::path& filepath, LoadFlags flags = LoadFlags::NONE);
+	// Contiguous run of words sharing one length.
+	struct WordRange {
+		const std::string_view* first;
+		size_t count;
+
+		const std::string_view* begin() const { return first; }
+		const std::string_view* end() const { return first + count; }
+		size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+		std::string_view operator[](size_t i) const { return first[i]; }
+	};
+
+	// Text files of ParallelLoadSize bytes or more are split into newline
+	// aligned chunks that are validated and sorted on a thread pool, then
+	// merged. A non zero length only keeps words of that length.
+	//
+	// Lines may follow the word with whitespace and a weight, such as a
+	// frequency count. Once any line has one, answers are drawn by weight and
+	// words without one weigh 1.
+	Dictionary(const std::filesystem::path& filepath, LoadFlags flags = LoadFlags::NONE, size_t length = 0);
 	Dictionary(const std::vector<std::string>& list, LoadFlags flags = LoadFlags::NONE);
+	// Views a compiled dictionary that stays in memory for as long as the
+	// Dictionary and its copies, such as one embedded in the executable.
+	Dictionary(const void* data, size_t size);
 	virtual ~Dictionary() {}
 
-	void Save(const std::filesystem::path& outpath);
-
-	bool Contains(const std::string& str);
-	std::optional<size_t> IndexOf(const std::string& str);
-	const std::string& GetWord(size_t i) const { if (i >= dictionary.size()) throw std::invalid_argument("Index out of bounds"); return dictionary[i]; }
+	// Writes the compiled binary format, which the path constructor detects
+	// and maps back without validating or sorting. Load flags are ignored for
+	// compiled files, a length still filters them.
+	void Save(const std::filesystem::path& outpath) const;
+	// The bytes Save writes
+	std::string Serialize() const;
+	// Header and bucket table of a compiled dictionary holding
+	// lengthCounts[len] words of each length, which have to follow it packed
+	// in length order
+	static std::string CompiledHeader(const std::vector<uint64_t>& lengthCounts, bool alphabetized, bool weighted = false);
+	// Zero bytes between the words and the weights of a compiled dictionary
+	static size_t WeightPadding(size_t wordBytes) { return (8 - wordBytes % 8) % 8; }
+	// Order of alphabetized dictionaries, by length then alphabetically.
+	// Anything producing or searching sorted word lists has to use it.
+	static bool WordOrder(std::string_view a, std::string_view b) {
+		if (a.length() != b.length()) return a.length() < b.length();
+		return a < b;
+	}
+
+	bool Contains(std::string_view str) const;
+	std::optional<size_t> IndexOf(std::string_view str) const;
+	std::string_view GetWord(size_t i) const { if (i >= dictionary.size()) throw std::invalid_argument("Index out of bounds"); return dictionary[i]; }
 	size_t WordCount() const { return dictionary.size(); }
 
-	const std::string& operator[](size_t idx) { return GetWord(idx); }
+	std::string_view operator[](size_t idx) const { return GetWord(idx); }
+
+	WordRange WordsOfLength(size_t len) const;
+	// Draws by weight with the bucket's alias table when the dictionary has
+	// weights, otherwise uniformly. Either way it's O(1).
+	template<typename URNG>
+	std::string_view RandomWord(size_t len, URNG& rng) const;
+
+	bool HasWeights() const { return !weights.empty(); }
+	double GetWeight(size_t i) const { return weights.empty() ? 1.0 : weights.at(i); }
+	// Weights lined up with WordsOfLength(len), nullptr without weights
+	const double* WeightsOfLength(size_t len) const;
 
 	void PrintSublist(size_t offset, size_t count) const;
 
@@ -66,9 +124,49 @@ public:
 	void SanitizeToLength(size_t length);
 
 private:
-	std::vector<std::string> dictionary;
-	// TODO: use binary search
+	static void LoadChunk(const char* buf, const char* end, LoadFlags flags, size_t length, std::vector<std::string_view>& out);
+	static void SortChunk(std::vector<std::string_view>::iterator first, std::vector<std::string_view>::iterator last, bool alphabetize);
+	void LoadCompiled(const char* data, size_t size);
+	// Parses the weight column following each word in the text [begin, end)
+	// the words are views into
+	void LoadWeights(const char* begin, const char* end);
+	void RemoveWords(bool (*remove)(std::string_view word, size_t length), size_t length);
+	void BuildBuckets();
+
+	// Walker's alias method as laid out by Vose. Slot i of a bucket is kept
+	// with probability[i], otherwise the draw moves to alias[i].
+	struct AliasTable {
+		std::vector<double> probability;
+		std::vector<uint32_t> alias;
+	};
+
+	// words are views into storage, which is shared between copies
+	std::shared_ptr<const void> storage;
+	std::vector<std::string_view> dictionary;
+	// words are always grouped by length, buckets[len] is { offset, count }
+	std::vector<std::pair<size_t, size_t>> buckets;
+	// weights[i] belongs to dictionary[i], empty when unweighted. aliases[len]
+	// is empty for buckets without a positive total weight.
+	std::vector<double> weights;
+	std::vector<AliasTable> aliases;
+	// sorted by length then alphabetically and deduplicated, IndexOf can
+	// binary search
 	bool alphabetized;
 };
 
+template<typename URNG>
+std::string_view Dictionary::RandomWord(size_t len, URNG& rng) const {
+	const auto words = WordsOfLength(len);
+	if (words.empty()) throw std::invalid_argument("No words of the requested length");
+
+	std::uniform_int_distribution<size_t> dist(0, words.size() - 1);
+	size_t i = dist(rng);
+	if (len < aliases.size() && !aliases[len].alias.empty()) {
+		const auto& table = aliases[len];
+		std::uniform_real_distribution<double> coin(0.0, 1.0);
+		if (coin(rng) >= table.probability[i]) i = table.alias[i];
+	}
+	return words[i];
+}
+
 #endif
@@ -0,0 +1,13 @@
+#include "embedded_dictionary.hpp"
+#include "embedded_words.hpp"
+#include "static_dictionary.hpp"
+
+// Sorting, bucketing and packing all happen while compiling this file, the
+// image ends up in .rodata
+namespace {
+constexpr auto index = StaticDictionary::Sort<StaticDictionary::CountLines(wordle_embedded_words)>(wordle_embedded_words);
+constexpr auto image = StaticDictionary::Compile<StaticDictionary::ImageSize(index)>(index);
+}
+
+const unsigned char* const wordle_embedded_dictionary = image.data();
+const size_t wordle_embedded_dictionary_size = image.size();
@@ -0,0 +1,12 @@
+#ifndef EMBEDDED_DICTIONARY_H
+#define EMBEDDED_DICTIONARY_H
+
+#include <cstddef>
+
+// Compiled dictionary built at compile time from the word list wordle-dict -e
+// generated into embedded_words.hpp. Only linked in when
+// WORDLE_EMBEDDED_DICTIONARY is defined.
+extern const unsigned char* const wordle_embedded_dictionary;
+extern const size_t wordle_embedded_dictionary_size;
+
+#endif
@@ -0,0 +1,76 @@
+#include "feedback.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FEEDBACK_SSE2
+#include <emmintrin.h>
+#endif
+
+static constexpr std::array<uint32_t, Feedback::MaxLength + 1> _powers_of_three = [] {
+	std::array<uint32_t, Feedback::MaxLength + 1> out{};
+	uint32_t p = 1;
+	for (auto& v : out) { v = p; p *= 3; }
+	return out;
+}();
+
+static uint32_t _green_mask(const Feedback::Word& guess, const Feedback::Word& answer, size_t len) {
+	uint32_t mask = 0;
+#ifdef FEEDBACK_SSE2
+	const __m128i g0 = _mm_loadu_si128((const __m128i*)guess.data());
+	const __m128i a0 = _mm_loadu_si128((const __m128i*)answer.data());
+	const __m128i g1 = _mm_loadu_si128((const __m128i*)(guess.data() + 16));
+	const __m128i a1 = _mm_loadu_si128((const __m128i*)(answer.data() + 16));
+	mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(g0, a0))
+		| ((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(g1, a1)) << 16);
+#else
+	for (size_t i = 0; i < len; ++i) {
+		mask |= (uint32_t)(guess[i] == answer[i]) << i;
+	}
+#endif
+	return mask & ((1u << len) - 1);
+}
+
+Feedback::Word Feedback::Load(std::string_view word) {
+	if (word.length() > MaxLength) throw std::invalid_argument("Word too long to score");
+
+	Word out{};
+	std::copy(word.begin(), word.end(), out.begin());
+	return out;
+}
+
+uint32_t Feedback::Score(const Word& guess, const Word& answer, size_t len) {
+	const uint32_t green = _green_mask(guess, answer, len);
+
+	// letters of the answer still available to mark yellow
+	uint8_t counts[256] = {};
+	for (size_t i = 0; i < len; ++i) {
+		if (!(green & (1u << i))) counts[(unsigned char)answer[i]]++;
+	}
+
+	uint32_t pattern = 0;
+	for (size_t i = 0; i < len; ++i) {
+		if (green & (1u << i)) {
+			pattern += Green * _powers_of_three[i];
+		}
+		else if (counts[(unsigned char)guess[i]] > 0) {
+			counts[(unsigned char)guess[i]]--;
+			pattern += Yellow * _powers_of_three[i];
+		}
+	}
+	return pattern;
+}
+
+uint32_t Feedback::Score(std::string_view guess, std::string_view answer) {
+	if (guess.length() != answer.length()) throw std::invalid_argument("Guess and answer lengths differ");
+	return Score(Load(guess), Load(answer), guess.length());
+}
+
+Feedback::Result Feedback::At(uint32_t pattern, size_t i) {
+	return (Result)((pattern / _powers_of_three[i]) % 3);
+}
+
+uint32_t Feedback::AllGreen(size_t len) {
+	return _powers_of_three[len] - 1;
+}
@@ -0,0 +1,76 @@
+#ifndef FEEDBACK_H
+#define FEEDBACK_H
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+
+// Wordle scoring kernel. A guess is scored against an answer into a base-3
+// pattern code where digit i (least significant first) is the result for
+// letter i. Repeated letters are only marked yellow as many times as they
+// appear in the answer outside of the green positions.
+class Feedback {
+public:
+	enum Result : uint8_t {
+		Grey = 0, Yellow = 1, Green = 2
+	};
+
+	// 3^20 still fits in a uint32_t
+	static constexpr size_t MaxLength = 20;
+	// words are zero padded so the green check can compare whole registers
+	typedef std::array<char, 32> Word;
+
+	static Word Load(std::string_view word);
+
+	static uint32_t Score(const Word& guess, const Word& answer, size_t len);
+	static uint32_t Score(std::string_view guess, std::string_view answer);
+
+	// Same scoring for words of a length known at compile time, so every loop
+	// can be unrolled. Up to 6 letters yellows are matched against unused
+	// answer letters directly, which is cheaper than the count table.
+	template<size_t N>
+	static uint32_t Score(const std::array<char, N>& guess, const std::array<char, N>& answer);
+
+	static Result At(uint32_t pattern, size_t i);
+	static uint32_t AllGreen(size_t len);
+};
+
+template<size_t N>
+uint32_t Feedback::Score(const std::array<char, N>& guess, const std::array<char, N>& answer) {
+	static_assert(N > 0 && N <= MaxLength, "Word length out of range");
+	if constexpr (N > 6) {
+		Word paddedGuess{}, paddedAnswer{};
+		std::copy(guess.begin(), guess.end(), paddedGuess.begin());
+		std::copy(answer.begin(), answer.end(), paddedAnswer.begin());
+		return Score(paddedGuess, paddedAnswer, N);
+	} else {
+		uint32_t green = 0;
+		for (size_t i = 0; i < N; ++i) {
+			green |= (uint32_t)(guess[i] == answer[i]) << i;
+		}
+
+		// answer letters already used by a green or yellow
+		uint32_t used = green;
+		Result results[N];
+		for (size_t i = 0; i < N; ++i) {
+			results[i] = Grey;
+			if (green >> i & 1) { results[i] = Green; continue; }
+
+			for (size_t j = 0; j < N; ++j) {
+				if (!(used >> j & 1) && guess[i] == answer[j]) {
+					used |= 1u << j;
+					results[i] = Yellow;
+					break;
+				}
+			}
+		}
+
+		uint32_t pattern = 0;
+		for (size_t i = N; i-- > 0;) pattern = pattern * 3 + results[i];
+		return pattern;
+	}
+}
+
+#endif
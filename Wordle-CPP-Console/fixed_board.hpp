@@ -0,0 +1,109 @@
+#ifndef FIXED_BOARD_H
+#define FIXED_BOARD_H
+
+#include "char_class.hpp"
+#include "feedback.hpp"
+#include "wordle_board.hpp"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Board for words of N letters. Works like Board, but rows are std::arrays
+// and scoring goes through Feedback::Score<N>, so the compiler can unroll
+// every per letter loop. Use Board for lengths without an instantiation.
+template<size_t N>
+class FixedBoard {
+public:
+	typedef std::array<char, N> Word;
+	static constexpr uint32_t EmptyRow = Board::EmptyRow;
+
+	FixedBoard(uint8_t attempts, std::string_view answer);
+	virtual ~FixedBoard() {}
+
+	void Reset(std::string_view answer);
+	// 0 while the game goes on, 1 when guess is the answer and 2 when the
+	// board ran out of attempts
+	int InsertGuess(const Word& guess);
+	int InsertGuess(std::string_view guess);
+
+	const std::string& GetAnswer() const { return answer; }
+	static constexpr size_t GetLength() { return N; }
+	size_t GetAttempts() const { return attempts; }
+	size_t GetCurrentRow() const { return currentRow; }
+	const char* GetRowLetters(size_t row) const { return letters[row].data(); }
+	uint32_t GetRowPattern(size_t row) const { return patterns[row]; }
+	bool IsRowSolved(size_t row) const { return patterns[row] == AllGreen(); }
+	uint32_t GetLastPattern() const { return lastPattern; }
+
+	static Word Load(std::string_view word);
+
+private:
+	static constexpr uint32_t AllGreen() {
+		uint32_t p = 1;
+		for (size_t i = 0; i < N; ++i) p *= 3;
+		return p - 1;
+	}
+
+	std::string answer;
+	Word answerWord;
+	size_t attempts, currentRow;
+	uint32_t lastPattern;
+
+	std::vector<Word> letters;
+	std::vector<uint32_t> patterns;
+};
+
+template<size_t N>
+FixedBoard<N>::FixedBoard(uint8_t attempts, std::string_view answer)
+	: attempts(attempts), currentRow(0), lastPattern(0) {
+	Reset(answer);
+}
+
+template<size_t N>
+typename FixedBoard<N>::Word FixedBoard<N>::Load(std::string_view word) {
+	if (word.length() != N) throw std::invalid_argument("Word length doesn't match the board");
+
+	Word out;
+	std::copy(word.begin(), word.end(), out.begin());
+	return out;
+}
+
+template<size_t N>
+void FixedBoard<N>::Reset(std::string_view answer) {
+	if (answer.length() != N || !CharClass::AllLetters(answer)) throw std::invalid_argument("Please pass a valid answer argument");
+
+	currentRow = 0;
+	lastPattern = 0;
+	Word blank;
+	blank.fill(' ');
+	letters.assign(attempts, blank);
+	patterns.assign(attempts, EmptyRow);
+
+	this->answer.assign(answer);
+	answerWord = Load(answer);
+}
+
+template<size_t N>
+int FixedBoard<N>::InsertGuess(const Word& guess) {
+	const uint32_t pattern = Feedback::Score<N>(guess, answerWord);
+	lastPattern = pattern;
+	patterns[currentRow] = pattern;
+	letters[currentRow] = guess;
+
+	if (pattern == AllGreen()) return 1;
+	if (++currentRow >= attempts) return 2;
+	return 0;
+}
+
+template<size_t N>
+int FixedBoard<N>::InsertGuess(std::string_view guess) {
+	return InsertGuess(Load(guess));
+}
+
+#endif
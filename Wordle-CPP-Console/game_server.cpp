@@ -0,0 +1,363 @@
+#include "game_server.hpp"
+#include "char_class.hpp"
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static const char* state_name(int state) {
+	static const char* names[] = { "IDLE", "PLAYING", "WON", "LOST" };
+	return names[state];
+}
+
+static std::string feedback_string(uint32_t pattern, size_t len) {
+	std::string str(len, '-');
+	for (size_t i = 0; i < len; ++i) {
+		switch (Feedback::At(pattern, i)) {
+		case Feedback::Green: str[i] = 'G'; break;
+		case Feedback::Yellow: str[i] = 'Y'; break;
+		default: break;
+		}
+	}
+	return str;
+}
+
+GameServer::GameServer(const Dictionary* dict, const WordSet* words, uint8_t attempts, size_t wordLen, size_t threads, const DailySchedule* schedule)
+	: dict(dict), words(words), schedule(schedule), attempts(attempts), wordLen(wordLen), threadCount(threads), listenFd(-1), stopFd(-1), tcp(false) {
+	if (dict->WordsOfLength(wordLen).empty()) throw std::invalid_argument("The dictionary has no words of the server's length");
+	if (schedule && schedule->WordLength() != wordLen) throw std::invalid_argument("The schedule's words aren't the server's length");
+	if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+	stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (stopFd < 0) throw std::runtime_error("Failed to create eventfd!");
+
+	try {
+		workers.resize(threadCount);
+		for (auto& worker : workers) {
+			worker.epoll = epoll_create1(EPOLL_CLOEXEC);
+			if (worker.epoll < 0) throw std::runtime_error("Failed to create epoll instance!");
+			worker.boards.reset(new BoardPool(attempts, wordLen));
+
+			epoll_event ev{};
+			ev.events = EPOLLIN;
+			ev.data.fd = stopFd;
+			if (epoll_ctl(worker.epoll, EPOLL_CTL_ADD, stopFd, &ev) != 0) throw std::runtime_error("Failed to watch eventfd!");
+		}
+	} catch (...) {
+		// the destructor doesn't run when the constructor throws
+		CloseAll();
+		throw;
+	}
+}
+
+GameServer::~GameServer() {
+	CloseAll();
+}
+
+void GameServer::CloseAll() {
+	for (auto& worker : workers) {
+		for (auto& session : worker.sessions) close(session.first);
+		if (worker.epoll >= 0) close(worker.epoll);
+	}
+	if (listenFd >= 0) close(listenFd);
+	if (stopFd >= 0) close(stopFd);
+	if (!socketPath.empty()) unlink(socketPath.c_str());
+}
+
+void GameServer::Listen(const std::string& address) {
+	if (listenFd >= 0) throw std::logic_error("Server is already listening");
+	if (address.empty()) throw std::invalid_argument("Empty listen address");
+
+	tcp = std::all_of(address.begin(), address.end(), [](char c) { return std::isdigit((unsigned char)c); });
+	int fd;
+	if (tcp) {
+		const unsigned long port = strtoul(address.c_str(), NULL, 10);
+		if (port == 0 || port > 65535) throw std::invalid_argument("Invalid port number");
+
+		fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		if (fd < 0) throw std::runtime_error("Failed to create socket!");
+		int one = 1;
+		setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+		sockaddr_in addr{};
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons((uint16_t)port);
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		if (bind(fd, (const sockaddr*)&addr, sizeof(addr)) != 0) { close(fd); throw std::runtime_error("Failed to bind port!"); }
+	}
+	else {
+		sockaddr_un addr{};
+		if (address.size() >= sizeof(addr.sun_path)) throw std::invalid_argument("Socket path is too long");
+		addr.sun_family = AF_UNIX;
+		memcpy(addr.sun_path, address.c_str(), address.size() + 1);
+
+		// only replace stale sockets, never other files
+		struct stat st;
+		if (lstat(address.c_str(), &st) == 0) {
+			if (!S_ISSOCK(st.st_mode)) throw std::runtime_error("Socket path exists and isn't a socket!");
+			unlink(address.c_str());
+		}
+
+		fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		if (fd < 0) throw std::runtime_error("Failed to create socket!");
+		if (bind(fd, (const sockaddr*)&addr, sizeof(addr)) != 0) { close(fd); throw std::runtime_error("Failed to bind socket!"); }
+		socketPath = address;
+	}
+
+	if (listen(fd, SOMAXCONN) != 0) { close(fd); throw std::runtime_error("Failed to listen on socket!"); }
+	listenFd = fd;
+}
+
+void GameServer::Run() {
+	if (listenFd < 0) throw std::logic_error("Server isn't listening");
+
+	// every worker waits on the socket, EPOLLEXCLUSIVE wakes only one of them
+	// per connection
+	for (auto& worker : workers) {
+		epoll_event ev{};
+		ev.events = EPOLLIN | EPOLLEXCLUSIVE;
+		ev.data.fd = listenFd;
+		if (epoll_ctl(worker.epoll, EPOLL_CTL_ADD, listenFd, &ev) != 0) throw std::runtime_error("Failed to watch socket!");
+	}
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < threadCount; ++i) {
+		threads.emplace_back(&GameServer::WorkerLoop, this, i);
+	}
+	WorkerLoop(0);
+	for (auto& t : threads) t.join();
+}
+
+void GameServer::Stop() {
+	const uint64_t one = 1;
+	ssize_t ret = write(stopFd, &one, sizeof(one));
+	(void)ret;
+}
+
+void GameServer::WorkerLoop(size_t w) {
+	Worker& worker = workers[w];
+	epoll_event events[64];
+
+	while (1) {
+		const int n = epoll_wait(worker.epoll, events, 64, -1);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			break;
+		}
+
+		for (int i = 0; i < n; ++i) {
+			const int fd = events[i].data.fd;
+			// the eventfd is never read, so it wakes every worker
+			if (fd == stopFd) goto stopped;
+			if (fd == listenFd) { Accept(worker); continue; }
+
+			auto it = worker.sessions.find(fd);
+			if (it == worker.sessions.end()) continue;
+			Session& session = it->second;
+
+			bool open = !(events[i].events & EPOLLERR);
+			if (open && (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP))) open = Read(worker, fd, session);
+			if (open && (events[i].events & EPOLLOUT)) {
+				open = Flush(worker, fd, session);
+				// replies drained below the cap, pick up the commands held back
+				if (open && !session.closing && !(session.events & EPOLLIN) && session.out.size() < MaxPendingOutput) open = Read(worker, fd, session);
+			}
+			if (!open || (session.closing && session.out.empty())) Close(worker, fd);
+		}
+	}
+
+stopped:
+	for (auto& session : worker.sessions) {
+		worker.boards->Release(session.second.board);
+		close(session.first);
+	}
+	worker.sessions.clear();
+}
+
+void GameServer::Accept(Worker& worker) {
+	while (1) {
+		const int fd = accept4(listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0) {
+			if (errno == EINTR) continue;
+			// EAGAIN once the backlog is drained, anything else (EMFILE) is
+			// retried on the next wake up
+			return;
+		}
+
+		if (tcp) {
+			int one = 1;
+			setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+		}
+
+		epoll_event ev{};
+		ev.events = EPOLLIN | EPOLLRDHUP;
+		ev.data.fd = fd;
+		if (epoll_ctl(worker.epoll, EPOLL_CTL_ADD, fd, &ev) != 0) { close(fd); continue; }
+		worker.sessions[fd].events = ev.events;
+	}
+}
+
+bool GameServer::Read(Worker& worker, int fd, Session& session) {
+	char buffer[4096];
+	bool eof = false;
+	// commands left over from when replies backed up go first. Reading stops
+	// at the cap and the socket buffers hold the client back until Flush
+	// drains the replies.
+	Process(worker, session);
+	while (!session.closing && session.out.size() < MaxPendingOutput) {
+		const ssize_t n = read(fd, buffer, sizeof(buffer));
+		if (n > 0) {
+			session.in.append(buffer, (size_t)n);
+			Process(worker, session);
+			continue;
+		}
+		if (n == 0) { eof = true; break; }
+		if (errno == EINTR) continue;
+		if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+		return false;
+	}
+	if (eof) session.closing = true;
+
+	return Flush(worker, fd, session);
+}
+
+void GameServer::Process(Worker& worker, Session& session) {
+	size_t start = 0, end;
+	while (!session.closing && session.out.size() < MaxPendingOutput && (end = session.in.find('\n', start)) != std::string::npos) {
+		std::string_view line(session.in.data() + start, end - start);
+		if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+		Handle(worker, session, line);
+		start = end + 1;
+	}
+	session.in.erase(0, start);
+
+	// only the unfinished last line counts, complete ones may be held back
+	const size_t last = session.in.rfind('\n');
+	if (!session.closing && session.in.size() - (last == std::string::npos ? 0 : last + 1) > MaxLineLength) {
+		session.out += "ERR line too long\n";
+		session.closing = true;
+	}
+}
+
+bool GameServer::Flush(Worker& worker, int fd, Session& session) {
+	size_t sent = 0;
+	while (sent < session.out.size()) {
+		const ssize_t n = send(fd, session.out.data() + sent, session.out.size() - sent, MSG_NOSIGNAL);
+		if (n >= 0) { sent += (size_t)n; continue; }
+		if (errno == EINTR) continue;
+		if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+		return false;
+	}
+	session.out.erase(0, sent);
+
+	// only ask for EPOLLOUT while there's something left to write, and stop
+	// reading once the session is closing or its replies back up
+	const bool reading = !session.closing && session.out.size() < MaxPendingOutput;
+	const uint32_t events = (reading ? uint32_t(EPOLLIN | EPOLLRDHUP) : 0u) | (session.out.empty() ? 0u : uint32_t(EPOLLOUT));
+	if (events != session.events) {
+		epoll_event ev{};
+		ev.events = events;
+		ev.data.fd = fd;
+		if (epoll_ctl(worker.epoll, EPOLL_CTL_MOD, fd, &ev) != 0) return false;
+		session.events = events;
+	}
+	return true;
+}
+
+void GameServer::Close(Worker& worker, int fd) {
+	auto it = worker.sessions.find(fd);
+	if (it == worker.sessions.end()) return;
+
+	worker.boards->Release(it->second.board);
+	worker.sessions.erase(it);
+	epoll_ctl(worker.epoll, EPOLL_CTL_DEL, fd, NULL);
+	close(fd);
+}
+
+void GameServer::Handle(Worker& worker, Session& session, std::string_view line) {
+	const size_t space = line.find(' ');
+	std::string command(line.substr(0, space));
+	std::string arg(space == std::string_view::npos ? std::string_view() : line.substr(space + 1));
+	std::transform(command.begin(), command.end(), command.begin(), [](char c) { return (char)std::toupper((unsigned char)c); });
+
+	std::string& out = session.out;
+	if (command == "NEW") {
+		if (!arg.empty()) {
+			if (arg.size() != wordLen || !CharClass::ToLower(arg)) { out += "ERR answer must be " + std::to_string(wordLen) + " letters\n"; return; }
+			if (!words->Contains(arg)) { out += "ERR answer isn't in the word list\n"; return; }
+		}
+
+		if (!session.board) session.board = arg.empty() ? worker.boards->Acquire(dict) : worker.boards->Acquire(arg);
+		else if (arg.empty()) session.board->Reset(dict, wordLen, wordLen);
+		else session.board->Reset(arg);
+		session.state = State::Playing;
+
+		out += "OK " + std::to_string(wordLen) + " " + std::to_string(attempts) + "\n";
+	}
+	else if (command == "DAILY") {
+		if (!schedule) { out += "ERR no daily schedule\n"; return; }
+		const int64_t today = DailySchedule::Today();
+		if (today < schedule->StartDay()) { out += "ERR the schedule hasn't started\n"; return; }
+
+		const auto answer = schedule->AnswerForDay(today);
+		if (!session.board) session.board = worker.boards->Acquire(answer);
+		else session.board->Reset(answer);
+		session.state = State::Playing;
+
+		out += "OK " + std::to_string(wordLen) + " " + std::to_string(attempts) + " " + std::to_string(today - schedule->StartDay() + 1) + "\n";
+	}
+	else if (command == "GUESS") {
+		if (session.state != State::Playing) { out += session.state == State::Idle ? "ERR no game\n" : "ERR game over\n"; return; }
+		if (arg.size() != wordLen || !CharClass::ToLower(arg)) { out += "ERR guess must be " + std::to_string(wordLen) + " letters\n"; return; }
+		if (!words->Contains(arg)) { out += "ERR guess isn't in the word list\n"; return; }
+
+		const int res = session.board->InsertGuess(arg);
+		if (res == 1) session.state = State::Won;
+		else if (res == 2) session.state = State::Lost;
+
+		out += "RESULT " + feedback_string(session.board->GetLastPattern(), wordLen) + " " + state_name((int)session.state);
+		if (session.state == State::Lost) out += " " + session.board->GetAnswer();
+		out += "\n";
+	}
+	else if (command == "STATE") {
+		out += "STATE ";
+		out += state_name((int)session.state);
+		if (!session.board) { out += " 0/" + std::to_string(attempts) + "\n"; return; }
+
+		const Board& board = *session.board;
+		size_t rows = 0;
+		while (rows < board.GetAttempts() && board.GetRowPattern(rows) != Board::EmptyRow) rows++;
+		out += " " + std::to_string(rows) + "/" + std::to_string(attempts);
+		for (size_t i = 0; i < rows; ++i) {
+			out += " ";
+			out.append(board.GetRowLetters(i), wordLen);
+			out += ":" + feedback_string(board.GetRowPattern(i), wordLen);
+		}
+		out += "\n";
+	}
+	else if (command == "QUIT") {
+		out += "BYE\n";
+		session.closing = true;
+	}
+	else {
+		out += "ERR unknown command\n";
+	}
+}
+
+#endif
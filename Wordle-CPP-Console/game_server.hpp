@@ -0,0 +1,97 @@
+#ifndef GAME_SERVER_H
+#define GAME_SERVER_H
+
+#ifdef __linux__
+
+#include "board_pool.hpp"
+#include "daily_schedule.hpp"
+#include "dictionary.hpp"
+#include "word_set.hpp"
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Hosts many games at once over a Unix domain socket or a loopback TCP port.
+// Every worker thread runs its own epoll loop, takes connections from the
+// shared listening socket and owns the sessions it accepted, so sessions are
+// never shared between threads. The dictionary and word set are only read.
+//
+// The protocol is one command per line, answered with one line:
+//   NEW [answer]   OK <length> <attempts>
+//   DAILY          OK <length> <attempts> <puzzle number>
+//   GUESS <word>   RESULT <feedback> PLAYING|WON|LOST [answer]
+//   STATE          STATE IDLE|PLAYING|WON|LOST <row>/<attempts> [word:feedback ...]
+//   QUIT           BYE, then the connection is closed
+// Feedback has a G for green, Y for yellow and - for grey letters. Failed
+// commands are answered with ERR <reason>. DAILY plays today's answer from
+// the schedule, if the server has one.
+class GameServer {
+public:
+	static constexpr size_t MaxLineLength = 256;
+	// replies a session can have unsent before the server stops reading its
+	// commands, so a client that never reads can't grow server memory
+	static constexpr size_t MaxPendingOutput = 64 << 10;
+
+	GameServer(const Dictionary* dict, const WordSet* words, uint8_t attempts, size_t wordLen, size_t threads = 0, const DailySchedule* schedule = nullptr);
+	GameServer(const GameServer&) = delete;
+	GameServer& operator=(const GameServer&) = delete;
+	virtual ~GameServer();
+
+	// address is a port number to listen on 127.0.0.1, or a socket path
+	void Listen(const std::string& address);
+	// Serves until Stop is called. The calling thread is worker 0.
+	void Run();
+	// Only writes to an eventfd, so it can be called from a signal handler
+	void Stop();
+
+	size_t ThreadCount() const { return threadCount; }
+
+private:
+	enum class State { Idle, Playing, Won, Lost };
+
+	struct Session {
+		Board* board = nullptr;
+		State state = State::Idle;
+		std::string in, out;
+		uint32_t events = 0;
+		bool closing = false;
+	};
+
+	struct Worker {
+		int epoll = -1;
+		std::unique_ptr<BoardPool> boards;
+		std::unordered_map<int, Session> sessions;
+	};
+
+	void WorkerLoop(size_t worker);
+	void Accept(Worker& worker);
+	bool Read(Worker& worker, int fd, Session& session);
+	void Process(Worker& worker, Session& session);
+	bool Flush(Worker& worker, int fd, Session& session);
+	void Close(Worker& worker, int fd);
+	void Handle(Worker& worker, Session& session, std::string_view line);
+	// Closes every descriptor the server holds, for the destructor and a
+	// constructor that failed halfway
+	void CloseAll();
+
+	const Dictionary* dict;
+	const WordSet* words;
+	const DailySchedule* schedule;
+	uint8_t attempts;
+	size_t wordLen, threadCount;
+
+	int listenFd, stopFd;
+	bool tcp;
+	std::string socketPath;
+	std::vector<Worker> workers;
+};
+
+#endif
+
+#endif
@@ -0,0 +1,189 @@
+#include "letter_index.hpp"
+#include "char_class.hpp"
+
+#include <stdexcept>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define LETTER_INDEX_AVX2
+#include <immintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static inline size_t popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+	return (size_t)__builtin_popcountll(x);
+#elif defined(_M_X64)
+	return (size_t)__popcnt64(x);
+#else
+	x = x - ((x >> 1) & 0x5555555555555555ull);
+	x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+	x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return (size_t)((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+// dst &= src, or dst &= ~src when negate is set
+typedef void (*AndFn)(uint64_t* dst, const uint64_t* src, size_t blocks, bool negate);
+typedef size_t (*CountFn)(const uint64_t* bits, size_t blocks);
+
+static void and_scalar(uint64_t* dst, const uint64_t* src, size_t blocks, bool negate) {
+	const uint64_t flip = negate ? ~0ull : 0;
+	for (size_t i = 0; i < blocks; ++i) dst[i] &= src[i] ^ flip;
+}
+
+static size_t count_scalar(const uint64_t* bits, size_t blocks) {
+	size_t count = 0;
+	for (size_t i = 0; i < blocks; ++i) count += popcount64(bits[i]);
+	return count;
+}
+
+#ifdef LETTER_INDEX_AVX2
+__attribute__((target("avx2")))
+static void and_avx2(uint64_t* dst, const uint64_t* src, size_t blocks, bool negate) {
+	size_t i = 0;
+	for (; i + 4 <= blocks; i += 4) {
+		const __m256i a = _mm256_loadu_si256((const __m256i*)(dst + i));
+		const __m256i b = _mm256_loadu_si256((const __m256i*)(src + i));
+		_mm256_storeu_si256((__m256i*)(dst + i), negate ? _mm256_andnot_si256(b, a) : _mm256_and_si256(a, b));
+	}
+	and_scalar(dst + i, src + i, blocks - i, negate);
+}
+
+// popcount of every byte from a nibble lookup, summed per 64 bit lane
+__attribute__((target("avx2")))
+static size_t count_avx2(const uint64_t* bits, size_t blocks) {
+	const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i low = _mm256_set1_epi8(0x0F);
+
+	__m256i total = _mm256_setzero_si256();
+	size_t i = 0;
+	for (; i + 4 <= blocks; i += 4) {
+		const __m256i v = _mm256_loadu_si256((const __m256i*)(bits + i));
+		const __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low)),
+			_mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low)));
+		total = _mm256_add_epi64(total, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+	}
+
+	size_t count = (size_t)_mm256_extract_epi64(total, 0) + (size_t)_mm256_extract_epi64(total, 1)
+		+ (size_t)_mm256_extract_epi64(total, 2) + (size_t)_mm256_extract_epi64(total, 3);
+	return count + count_scalar(bits + i, blocks - i);
+}
+#endif
+
+struct BitKernels {
+	AndFn andFn;
+	CountFn countFn;
+	const char* name;
+};
+
+static BitKernels pick_kernels() {
+#ifdef LETTER_INDEX_AVX2
+	__builtin_cpu_init();
+	if (CharClass::SimdAllowed("avx2") && __builtin_cpu_supports("avx2")) return { and_avx2, count_avx2, "avx2" };
+#endif
+	return { and_scalar, count_scalar, "scalar" };
+}
+
+static const BitKernels& kernels() {
+	static const BitKernels picked = pick_kernels();
+	return picked;
+}
+
+LetterIndex::Query LetterIndex::Query::Parse(std::string_view str) {
+	Query query;
+	size_t part = 0;
+	for (char c : str) {
+		if (c == ':') {
+			if (++part > 2) throw std::invalid_argument("Query has too many parts");
+			continue;
+		}
+		if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+
+		if (part == 0) {
+			if (c == '.') c = '?';
+			if (c != '?' && (c < 'a' || c > 'z')) throw std::invalid_argument("Query pattern must be letters or '?'");
+			query.pattern += c;
+			continue;
+		}
+
+		if (c < 'a' || c > 'z') throw std::invalid_argument("Query letters must be a-z");
+		if (part == 1) query.excluded |= 1u << (c - 'a');
+		else query.minCount[c - 'a']++;
+	}
+
+	if (query.pattern.empty()) throw std::invalid_argument("Query needs a pattern");
+	return query;
+}
+
+LetterIndex::LetterIndex(Dictionary::WordRange words)
+	: words(words), wordLen(words.empty() ? 0 : words[0].length()), blocks((words.size() + 63) / 64) {
+	positionBits.assign(wordLen * 26 * blocks, 0);
+	countBits.assign(26 * wordLen * blocks, 0);
+
+	for (size_t id = 0; id < words.size(); ++id) {
+		const auto word = words[id];
+		if (word.length() != wordLen) throw std::invalid_argument("Index words must all have the same length");
+
+		const uint64_t bit = 1ull << (id % 64);
+		uint8_t counts[26] = {};
+		for (size_t pos = 0; pos < wordLen; ++pos) {
+			const unsigned letter = (unsigned char)word[pos] - 'a';
+			// words with anything but lowercase letters never match a query
+			if (letter >= 26) continue;
+
+			positionBits[(pos * 26 + letter) * blocks + id / 64] |= bit;
+			const size_t count = ++counts[letter];
+			countBits[(letter * wordLen + count - 1) * blocks + id / 64] |= bit;
+		}
+	}
+}
+
+void LetterIndex::Evaluate(const Query& query, std::vector<uint64_t>& result) const {
+	if (query.pattern.length() != wordLen) throw std::invalid_argument("Query pattern length doesn't match the index");
+
+	result.assign(blocks, ~0ull);
+	if (words.size() % 64) result.back() = (1ull << (words.size() % 64)) - 1;
+
+	const AndFn andBits = kernels().andFn;
+	for (size_t pos = 0; pos < wordLen; ++pos) {
+		const char c = query.pattern[pos];
+		if (c != '?') andBits(result.data(), PositionBits(pos, c - 'a'), blocks, false);
+	}
+
+	for (size_t letter = 0; letter < 26; ++letter) {
+		const size_t min = query.minCount[letter];
+		if (min > wordLen) { result.assign(blocks, 0); return; }
+		if (min) andBits(result.data(), CountBits(letter, min), blocks, false);
+		if (query.excluded >> letter & 1) andBits(result.data(), CountBits(letter, 1), blocks, true);
+	}
+}
+
+size_t LetterIndex::Count(const Query& query) const {
+	std::vector<uint64_t> result;
+	Evaluate(query, result);
+	return kernels().countFn(result.data(), result.size());
+}
+
+std::vector<uint32_t> LetterIndex::Matches(const Query& query) const {
+	std::vector<uint64_t> result;
+	Evaluate(query, result);
+
+	std::vector<uint32_t> ids;
+	ids.reserve(kernels().countFn(result.data(), result.size()));
+	for (size_t block = 0; block < result.size(); ++block) {
+		for (uint64_t bits = result[block]; bits; bits &= bits - 1) {
+			// bits below the lowest set one
+			const size_t bit = popcount64((bits & (0 - bits)) - 1);
+			ids.push_back((uint32_t)(block * 64 + bit));
+		}
+	}
+	return ids;
+}
+
+const char* LetterIndex::Implementation() {
+	return kernels().name;
+}
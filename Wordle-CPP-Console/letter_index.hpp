@@ -0,0 +1,58 @@
+#ifndef LETTER_INDEX_H
+#define LETTER_INDEX_H
+
+#include "dictionary.hpp"
+
+#include <stdint.h>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Inverted index over words of one length. Every (position, letter) and
+// every (letter, at least n copies) pair has a bitset of word ids, the
+// word's index in the range. Queries AND the bitsets together and popcount
+// the result, 256 bits at a time with AVX2 when the CPU has it.
+class LetterIndex {
+public:
+	struct Query {
+		// a letter or '?' for every position
+		std::string pattern;
+		// letters that can't appear anywhere
+		uint32_t excluded = 0;
+		// letters that have to appear at least this often
+		std::array<uint8_t, 26> minCount{};
+
+		// "g?e?s:a:r" is g?e?s without an a and with at least one r. Letters
+		// repeated in the last part have to appear that many times.
+		static Query Parse(std::string_view str);
+	};
+
+	LetterIndex(Dictionary::WordRange words);
+	virtual ~LetterIndex() {}
+
+	size_t Count(const Query& query) const;
+	// ids of the matching words, in dictionary order
+	std::vector<uint32_t> Matches(const Query& query) const;
+
+	std::string_view GetWord(size_t id) const { return words[id]; }
+	size_t WordCount() const { return words.size(); }
+	size_t WordLength() const { return wordLen; }
+
+	// "avx2" or "scalar"
+	static const char* Implementation();
+
+private:
+	void Evaluate(const Query& query, std::vector<uint64_t>& result) const;
+
+	const uint64_t* PositionBits(size_t pos, size_t letter) const { return positionBits.data() + (pos * 26 + letter) * blocks; }
+	const uint64_t* CountBits(size_t letter, size_t count) const { return countBits.data() + (letter * wordLen + count - 1) * blocks; }
+
+	Dictionary::WordRange words;
+	size_t wordLen, blocks;
+	std::vector<uint64_t> positionBits;
+	std::vector<uint64_t> countBits;
+};
+
+#endif
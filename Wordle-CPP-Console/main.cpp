@@ -1,38 +1,122 @@
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
 #include <iomanip>
+#include <random>
 #include <csignal>
 
+#include "char_class.hpp"
+#include "constraints.hpp"
+#include "daily_schedule.hpp"
 #include "dictionary.hpp"
+#include "embedded_dictionary.hpp"
+#include "fixed_board.hpp"
+#include "letter_index.hpp"
+#include "game_server.hpp"
+#include "pattern_matrix.hpp"
+#include "renderer.hpp"
+#include "simulator.hpp"
+#include "solver.hpp"
+#include "thread_pool.hpp"
+#include "thread_rng.hpp"
+#include "word_set.hpp"
 #include "wordle_board.hpp"
 #include "getopt.h"
 
-Board* board;
+// answer of the game being played, for the SIGINT handler
+const std::string* game_answer;
+#ifdef __linux__
+GameServer* server;
+#endif
 
 void print_help(void);
 extern "C" void sigint_handler(int);
 
-const std::string get_sanitized_input(Board*);
-const std::string get_input_valid(Board*, Dictionary* dict);
+struct GameOptions {
+	uint8_t attempts;
+	size_t solveCount;
+	const char* cacheDir;
+	bool incremental, hardMode;
+};
+
+template<typename B>
+int play_game(B&& board, const Dictionary* list, const WordSet* words, const GameOptions& options);
+const std::string get_sanitized_input(size_t length);
+const std::string get_input_valid(size_t length, const WordSet* words, const Constraints* constraints);
+void print_suggestions(const Solver* solver, ThreadPool* pool, size_t count);
+int run_simulation(Dictionary* list, const char* strategy_name, const char* cache_dir, size_t attempts);
+int run_query(Dictionary* list, const char* query_string);
+int run_schedule(Dictionary* list, const char* filename, const char* seed_string, size_t length);
+int run_server(Dictionary* list, const WordSet* words, const char* address, size_t attempts, const DailySchedule* schedule);
 
 int main(int argc, char* argv[]) {
 	std::cout << "Wordle clone by Adam Warren (c) 2022" << std::endl;
-	srand((unsigned int)time(NULL));
 
 	int opt = 0;
 	char* answer = NULL;
 	char* dict_filename = NULL;
-	unsigned int num_trys = 6, parse;
-	while ((opt = getopt(argc, argv, "ha:d:t:")) != -1) {
+	char* compile_filename = NULL;
+	char* cache_dir = NULL;
+	char* strategy_name = NULL;
+	char* listen_address = NULL;
+	char* query_string = NULL;
+	char* daily_filename = NULL;
+	char* schedule_filename = NULL;
+	char* seed_string = NULL;
+	bool incremental = false;
+	bool hard_mode = false;
+	const size_t min_word_len = 5, max_word_len = 5;
+	unsigned int num_trys = 6, solve_count = 0, parse;
+	while ((opt = getopt(argc, argv, "D:Hha:c:d:g:il:m:p:q:r:s:t:")) != -1) {
 		switch (opt) {
 		case 'a':
 			answer = optarg;
 			break;
+		case 'c':
+			compile_filename = optarg;
+			break;
 		case 'd':
 			dict_filename = optarg;
 			break;
+		case 'D':
+			daily_filename = optarg;
+			break;
+		case 'g':
+			schedule_filename = optarg;
+			break;
+		case 'H':
+			hard_mode = true;
+			break;
+		case 'i':
+			incremental = true;
+			break;
+		case 'l':
+			listen_address = optarg;
+			break;
+		case 'm':
+			strategy_name = optarg;
+			break;
+		case 'p':
+			cache_dir = optarg;
+			break;
+		case 'q':
+			query_string = optarg;
+			break;
+		case 'r':
+			seed_string = optarg;
+			break;
+		case 's':
+			parse = strtoul(optarg, NULL, 10);
+			if (errno == ERANGE || optarg[0] == '-') {
+				puts("Unable to parse number after -s");
+				print_help();
+				return 0;
+			}
+			solve_count = parse;
+			break;
 		case 't':
 			parse = strtoul(optarg, NULL, 10);
 			if (errno == ERANGE || optarg[0] == '-') {
@@ -55,75 +139,334 @@ int main(int argc, char* argv[]) {
 	if (dict_filename) {
 		list = new Dictionary(std::filesystem::path(dict_filename));
 	} else {
+#ifdef WORDLE_EMBEDDED_DICTIONARY
+		list = new Dictionary(wordle_embedded_dictionary, wordle_embedded_dictionary_size);
+#else
 		list = new Dictionary("engmix.txt", Dictionary::LoadFlags::LOWER_ONLY);
+#endif
+	}
+
+	if (compile_filename) {
+		list->Save(std::filesystem::path(compile_filename));
+		std::cout << "Compiled " << list->WordCount() << " words to " << std::quoted(compile_filename) << std::endl;
+		delete list;
+		return 0;
+	}
+
+	if (schedule_filename) {
+		int ret = run_schedule(list, schedule_filename, seed_string, min_word_len);
+		delete list;
+		return ret;
 	}
 
+	if (query_string) {
+		int ret = run_query(list, query_string);
+		delete list;
+		return ret;
+	}
+
+	if (strategy_name) {
+		int ret = run_simulation(list, strategy_name, cache_dir, num_trys);
+		delete list;
+		return ret;
+	}
+
+	WordSet words(list);
+
+	DailySchedule* schedule = nullptr;
+	if (daily_filename) {
+		try {
+			schedule = new DailySchedule(std::filesystem::path(daily_filename));
+		} catch (const std::exception& e) {
+			std::cout << "Unable to load the schedule: " << e.what() << std::endl;
+			delete list;
+			return EXIT_FAILURE;
+		}
+		if (schedule->Hash() != DailySchedule::HashWords(list->WordsOfLength(schedule->WordLength()))) {
+			std::cout << "The schedule was made from a different dictionary!" << std::endl;
+			delete schedule;
+			delete list;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (listen_address) {
+		int ret = run_server(list, &words, listen_address, num_trys, schedule);
+		delete schedule;
+		delete list;
+		return ret;
+	}
+
+	if (answer && !words.Contains(answer)) {
+		std::cout << "User answer isn't contained in the provided dictionary!" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::string chosen;
 	if (answer) {
-		if(!list->Contains(answer)) {
-			std::cout << "User answer isn't contained in the provided dictionary!" << std::endl;
+		chosen = answer;
+	}
+	else if (schedule) {
+		const int64_t today = DailySchedule::Today();
+		if (today < schedule->StartDay()) {
+			std::cout << "The schedule starts in " << schedule->StartDay() - today << " days!" << std::endl;
+			delete schedule;
+			delete list;
 			return EXIT_FAILURE;
 		}
-		board = new Board(num_trys, answer);
+		std::cout << "Daily puzzle #" << today - schedule->StartDay() + 1 << std::endl;
+		chosen = std::string(schedule->AnswerForDay(today));
 	}
 	else {
-		board = new Board(num_trys, list, 5, 5);
+		std::uniform_int_distribution<size_t> lengths(min_word_len, max_word_len);
+		chosen = std::string(list->RandomWord(lengths(thread_rng()), thread_rng()));
+	}
+
+	GameOptions options{ (uint8_t)num_trys, solve_count, cache_dir, incremental, hard_mode };
+	int ret;
+	switch (chosen.length()) {
+	case 4: ret = play_game(FixedBoard<4>(options.attempts, chosen), list, &words, options); break;
+	case 5: ret = play_game(FixedBoard<5>(options.attempts, chosen), list, &words, options); break;
+	case 6: ret = play_game(FixedBoard<6>(options.attempts, chosen), list, &words, options); break;
+	case 7: ret = play_game(FixedBoard<7>(options.attempts, chosen), list, &words, options); break;
+	case 8: ret = play_game(FixedBoard<8>(options.attempts, chosen), list, &words, options); break;
+	default: ret = play_game(Board(options.attempts, chosen), list, &words, options); break;
+	}
+
+	delete schedule;
+	delete list;
+	return ret;
+}
+
+template<typename B>
+int play_game(B&& board, const Dictionary* list, const WordSet* words, const GameOptions& options) {
+	ThreadPool* pool = nullptr;
+	PatternMatrix* matrix = nullptr;
+	Solver* solver = nullptr;
+	if (options.solveCount) {
+		if (board.GetLength() > PatternMatrix::MaxLength) {
+			std::cout << "The solver only supports words up to " << PatternMatrix::MaxLength << " letters!" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		const auto bucket = list->WordsOfLength(board.GetLength());
+		pool = new ThreadPool();
+		if (options.cacheDir) matrix = new PatternMatrix(bucket, bucket, *pool, std::filesystem::path(options.cacheDir));
+		else matrix = new PatternMatrix(bucket, bucket, *pool);
+		solver = new Solver(matrix, bucket);
+		solver->SetHardMode(options.hardMode);
 	}
 
-	
-	board->Print();
+	Constraints* constraints = nullptr;
+	if (options.hardMode) constraints = new Constraints(list->WordsOfLength(board.GetLength()));
+	game_answer = &board.GetAnswer();
 
-	auto input = get_input_valid(board, list);
+	Renderer renderer(options.incremental);
+	renderer.Draw(board);
+	if (solver) print_suggestions(solver, pool, options.solveCount);
+
+	auto input = get_input_valid(board.GetLength(), words, constraints);
 	std::cout << "Entered the word " << input << std::endl;
 
 	int res;
-	while ((res = board->InsertGuess(input)) == 0) {
-		board->Print();
-		input = get_input_valid(board, list);
+	while ((res = board.InsertGuess(input)) == 0) {
+		renderer.Draw(board);
+		if (constraints) constraints->Update(input, board.GetLastPattern());
+		if (solver) {
+			solver->Filter(*solver->GuessIndex(input), board.GetLastPattern());
+			print_suggestions(solver, pool, options.solveCount);
+		}
+		input = get_input_valid(board.GetLength(), words, constraints);
 	}
 
-	board->Print();
+	renderer.Draw(board);
+	std::cout << (res == 1 ? "You win!!" : "You lose!") << std::endl;
 
 	if (res == 2) {
-		std::cout << "Better luck next time, the answer was " << std::quoted(board->GetAnswer()) << std::endl;
+		std::cout << "Better luck next time, the answer was " << std::quoted(board.GetAnswer()) << std::endl;
 	}
-	
-	delete board;
-	delete list;
+	game_answer = nullptr;
+
+	delete constraints;
+	delete solver;
+	delete matrix;
+	delete pool;
 	return 0;
 }
 
 void sigint_handler(int param) {
-	if (board) std::cout << std::endl << "The answer was " << std::quoted(board->GetAnswer()) << std::endl;
+#ifdef __linux__
+	if (server) { server->Stop(); return; }
+#endif
+	if (game_answer) std::cout << std::endl << "The answer was " << std::quoted(*game_answer) << std::endl;
 	exit(0);
 }
 
 void print_help(void) {
+	std::cout << " -D file  \t Play today's answer from a daily schedule, or serve it to DAILY with -l." << std::endl;
+	std::cout << " -H       \t Hard mode, every guess has to fit all the feedback so far." << std::endl;
 	std::cout << " -a answer\t Answer to the board." << std::endl;
-	std::cout << " -d file  \t Location to a dictionary file in plain text form." << std::endl;
+	std::cout << " -c file  \t Compile the dictionary to a binary file and exit." << std::endl;
+	std::cout << " -d file  \t Location to a dictionary file in plain text, optionally with a weight after each word, or compiled form. (default=built in, or engmix.txt)" << std::endl;
+	std::cout << " -g file  \t Shuffle every 5 letter answer into a daily schedule starting today and exit." << std::endl;
+	std::cout << " -i       \t Redraw the board in place, only rewriting lines that changed." << std::endl;
+	std::cout << " -l addr  \t Serve games over a loopback TCP port or a Unix socket path (Linux only)." << std::endl;
+	std::cout << " -m name  \t Simulate every 5 letter answer with a strategy (entropy, random) and exit." << std::endl;
+	std::cout << " -p dir   \t Directory to cache solver pattern tables in." << std::endl;
+	std::cout << " -q query \t Print the words matching a query like g?e?s:a:r (no a, at least one r) and exit." << std::endl;
+	std::cout << " -r seed  \t Seed of the schedule made by -g. (default=random)" << std::endl;
+	std::cout << " -s num   \t Solver mode, print the num best guesses every turn." << std::endl;
 	std::cout << " -t num   \t Number of rounds. (default=5)" << std::endl;
 }
 
-const std::string get_input_valid(Board* brd, Dictionary* dict) {
+void print_suggestions(const Solver* solver, ThreadPool* pool, size_t count) {
+	const auto start = std::chrono::steady_clock::now();
+	const auto ranked = solver->Rank(count, pool);
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+	std::cout << solver->GetCandidates().size() << " possible answers left, ranked in " << elapsed.count() << " ms" << std::endl;
+	for (const auto& guess : ranked) {
+		std::cout << "  " << solver->GetGuess(guess.guess) << "  " << std::fixed << std::setprecision(3) << guess.entropy << " bits" << std::endl;
+	}
+}
+
+int run_simulation(Dictionary* list, const char* strategy_name, const char* cache_dir, size_t attempts) {
+	const auto bucket = list->WordsOfLength(5);
+	if (bucket.empty()) {
+		std::cout << "The dictionary has no 5 letter words!" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	ThreadPool pool;
+	PatternMatrix* matrix;
+	if (cache_dir) matrix = new PatternMatrix(bucket, bucket, pool, std::filesystem::path(cache_dir));
+	else matrix = new PatternMatrix(bucket, bucket, pool);
+
+	std::unique_ptr<Strategy> strategy;
+	try {
+		strategy = Strategy::Create(strategy_name, matrix, bucket, pool);
+	} catch (const std::invalid_argument&) {
+		std::cout << "Unknown strategy " << std::quoted(strategy_name) << std::endl;
+		delete matrix;
+		return EXIT_FAILURE;
+	}
+
+	const auto result = simulate(*strategy, bucket, attempts, pool, list->WeightsOfLength(5));
+	delete matrix;
+
+	std::cout << "Played " << result.games << " games on " << pool.ThreadCount() << " threads in " << std::fixed << std::setprecision(3) << result.seconds << " s ("
+		<< std::setprecision(0) << result.games / result.seconds << " games/sec)" << std::endl;
+	std::cout << "Solved " << result.solved << "/" << result.games << ", average " << std::setprecision(3) << result.averageGuesses
+		<< " guesses, max " << result.maxGuesses << std::endl;
+	if (list->HasWeights()) {
+		std::cout << "Weighted by frequency, solved " << std::setprecision(2) << result.weightedSolveRate * 100 << "%, average "
+			<< std::setprecision(3) << result.weightedAverageGuesses << " guesses" << std::endl;
+	}
+	for (size_t n = 1; n <= attempts; ++n) {
+		std::cout << std::setw(3) << n << ": " << result.distribution[n] << std::endl;
+	}
+	std::cout << "  X: " << result.distribution[0] << std::endl;
+	return 0;
+}
+
+int run_query(Dictionary* list, const char* query_string) {
+	LetterIndex::Query query;
+	try {
+		query = LetterIndex::Query::Parse(query_string);
+	} catch (const std::invalid_argument& e) {
+		std::cout << "Invalid query " << std::quoted(query_string) << ": " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const auto bucket = list->WordsOfLength(query.pattern.length());
+	if (bucket.empty()) {
+		std::cout << "The dictionary has no " << query.pattern.length() << " letter words!" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const LetterIndex index(bucket);
+	const auto start = std::chrono::steady_clock::now();
+	const auto matches = index.Matches(query);
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+	std::cout << matches.size() << " of " << index.WordCount() << " words match, found in " << elapsed.count() << " us" << std::endl;
+	for (uint32_t id : matches) {
+		std::cout << "  " << index.GetWord(id) << std::endl;
+	}
+	return 0;
+}
+
+int run_schedule(Dictionary* list, const char* filename, const char* seed_string, size_t length) {
+	uint64_t seed;
+	if (seed_string) {
+		char* end;
+		errno = 0;
+		seed = strtoull(seed_string, &end, 10);
+		if (errno == ERANGE || seed_string[0] < '0' || seed_string[0] > '9' || *end != '\0') {
+			puts("Unable to parse number after -r");
+			print_help();
+			return EXIT_FAILURE;
+		}
+	}
+	else {
+		seed = thread_rng()();
+	}
+
+	const auto bucket = list->WordsOfLength(length);
+	if (bucket.empty()) {
+		std::cout << "The dictionary has no " << length << " letter words!" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const DailySchedule schedule(bucket, seed, DailySchedule::Today());
+	schedule.Save(std::filesystem::path(filename));
+	std::cout << "Scheduled " << schedule.Count() << " daily answers with seed " << seed << " to " << std::quoted(filename) << std::endl;
+	return 0;
+}
+
+int run_server(Dictionary* list, const WordSet* words, const char* address, size_t attempts, const DailySchedule* schedule) {
+#ifdef __linux__
+	try {
+		server = new GameServer(list, words, (uint8_t)attempts, 5, 0, schedule);
+		server->Listen(address);
+	} catch (const std::exception& e) {
+		std::cout << "Unable to start the server: " << e.what() << std::endl;
+		delete server;
+		server = nullptr;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "Serving games on " << std::quoted(address) << " with " << server->ThreadCount() << " threads" << std::endl;
+	server->Run();
+
+	GameServer* stopped = server;
+	server = nullptr;
+	delete stopped;
+	std::cout << "Server stopped" << std::endl;
+	return 0;
+#else
+	std::cout << "Server mode is only supported on Linux!" << std::endl;
+	return EXIT_FAILURE;
+#endif
+}
+
+const std::string get_input_valid(size_t length, const WordSet* words, const Constraints* constraints) {
 	while (1) {
-		const std::string input = get_sanitized_input(brd);
-		if (dict->Contains(input)) return input;
-		std::cout << "Enter a valid english word." << std::endl;
+		const std::string input = get_sanitized_input(length);
+		if (!words->Contains(input)) { std::cout << "Enter a valid english word." << std::endl; continue; }
+		if (!constraints || constraints->Allows(input)) return input;
+		std::cout << constraints->Violation(input) << "!" << std::endl;
 	}
 }
 
-const std::string get_sanitized_input(Board* brd) {
+const std::string get_sanitized_input(size_t length) {
 	while (1) {
-		printf("Enter a %zu letter word to try: ", brd->GetLength());
+		printf("Enter a %zu letter word to try: ", length);
 		std::string str;
 		std::getline(std::cin, str);
-		if (str.length() != brd->GetLength()) { printf("The word entered was not %zu letters long!\n", brd->GetLength()); continue; }
-
-		bool invalid = false;
-		std::for_each(str.begin(), str.end(), [&invalid](char& c) {
-			if (std::isupper(c)) c += 'a' - 'A';
-			if (!std::islower(c)) { std::cout << "Please enter only letters!" << std::endl; invalid = true; }
-		});
+		if (str.length() != length) { printf("The word entered was not %zu letters long!\n", length); continue; }
 
-		if (!invalid) return str;
+		if (CharClass::ToLower(str)) return str;
+		std::cout << "Please enter only letters!" << std::endl;
 	}
 }
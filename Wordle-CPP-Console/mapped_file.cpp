@@ -0,0 +1,63 @@
+#include "mapped_file.hpp"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& filepath)
+	: data(nullptr), size(0), file(INVALID_HANDLE_VALUE), mapping(nullptr) {
+	file = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Failed to open file!");
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize)) { CloseHandle(file); throw std::runtime_error("Failed to stat file!"); }
+	size = (size_t)fileSize.QuadPart;
+	if (size == 0) return;
+
+	mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!mapping) { CloseHandle(file); throw std::runtime_error("Failed to map file!"); }
+
+	data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!data) { CloseHandle(mapping); CloseHandle(file); throw std::runtime_error("Failed to map file!"); }
+}
+
+MappedFile::~MappedFile() {
+	if (data) UnmapViewOfFile(data);
+	if (mapping) CloseHandle(mapping);
+	if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& filepath)
+	: data(nullptr), size(0) {
+	int fd = open(filepath.c_str(), O_RDONLY);
+	if (fd < 0) throw std::runtime_error("Failed to open file!");
+
+	struct stat st;
+	if (fstat(fd, &st) != 0) { close(fd); throw std::runtime_error("Failed to stat file!"); }
+	size = (size_t)st.st_size;
+	if (size == 0) { close(fd); return; }
+
+	void* addr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED) throw std::runtime_error("Failed to map file!");
+
+	data = (const char*)addr;
+}
+
+MappedFile::~MappedFile() {
+	if (data) munmap((void*)data, size);
+}
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <filesystem>
+
+// Read-only memory mapping of a whole file. Views handed out by Data() stay
+// valid for the lifetime of the object.
+class MappedFile {
+public:
+	MappedFile(const std::filesystem::path& filepath);
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	virtual ~MappedFile();
+
+	const char* Data() const { return data; }
+	size_t Size() const { return size; }
+
+private:
+	const char* data;
+	size_t size;
+#ifdef _WIN32
+	void* file;
+	void* mapping;
+#endif
+};
+
+#endif
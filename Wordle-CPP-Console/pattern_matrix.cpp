@@ -0,0 +1,139 @@
+#include "pattern_matrix.hpp"
+#include "feedback.hpp"
+#include "mapped_file.hpp"
+#include "word_hash.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#define PATTERN_MAGIC "WPAT"
+#define PATTERN_VERSION 1
+
+struct PatternHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t wordLength;
+	uint32_t reserved;
+	uint64_t guessCount;
+	uint64_t answerCount;
+	uint64_t hash;
+};
+
+static size_t _list_length(Dictionary::WordRange guesses, Dictionary::WordRange answers) {
+	size_t len = !guesses.empty() ? guesses[0].length() : !answers.empty() ? answers[0].length() : 0;
+	if (len == 0 || len > PatternMatrix::MaxLength) throw std::invalid_argument("Pattern matrix word length out of range");
+	return len;
+}
+
+PatternMatrix::PatternMatrix(Dictionary::WordRange guesses, Dictionary::WordRange answers, ThreadPool& pool)
+	: data(nullptr), guessCount(guesses.size()), answerCount(answers.size()), wordLen(_list_length(guesses, answers)) {
+	hash = HashLists(guesses, answers);
+	Compute(guesses, answers, pool);
+}
+
+PatternMatrix::PatternMatrix(Dictionary::WordRange guesses, Dictionary::WordRange answers, ThreadPool& pool, const std::filesystem::path& cacheDir)
+	: data(nullptr), guessCount(guesses.size()), answerCount(answers.size()), wordLen(_list_length(guesses, answers)) {
+	hash = HashLists(guesses, answers);
+
+	std::ostringstream name;
+	name << "patterns-" << wordLen << "-" << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+	const auto filepath = cacheDir / name.str();
+
+	if (TryLoad(filepath)) return;
+
+	Compute(guesses, answers, pool);
+	std::filesystem::create_directories(cacheDir);
+	Save(filepath);
+}
+
+void PatternMatrix::Compute(Dictionary::WordRange guesses, Dictionary::WordRange answers, ThreadPool& pool) {
+	auto matrix = std::make_shared<std::vector<uint8_t>>(guessCount * answerCount);
+	uint8_t* out = matrix->data();
+
+	std::vector<Feedback::Word> answerWords(answerCount);
+	for (size_t i = 0; i < answerCount; ++i) answerWords[i] = Feedback::Load(answers[i]);
+
+	pool.ParallelFor(guessCount, 16, [&](size_t begin, size_t end, size_t) {
+		for (size_t g = begin; g < end; ++g) {
+			const auto guess = Feedback::Load(guesses[g]);
+			uint8_t* row = out + g * answerCount;
+			for (size_t a = 0; a < answerCount; ++a) {
+				row[a] = (uint8_t)Feedback::Score(guess, answerWords[a], wordLen);
+			}
+		}
+		});
+
+	data = out;
+	storage = matrix;
+}
+
+bool PatternMatrix::TryLoad(const std::filesystem::path& filepath) {
+	if (!std::filesystem::exists(filepath)) return false;
+
+	auto file = std::make_shared<MappedFile>(filepath);
+	if (file->Size() < sizeof(PatternHeader)) return false;
+
+	PatternHeader header;
+	std::memcpy(&header, file->Data(), sizeof(header));
+	if (std::memcmp(header.magic, PATTERN_MAGIC, 4) != 0 || header.version != PATTERN_VERSION) return false;
+	if (header.wordLength != wordLen || header.guessCount != guessCount || header.answerCount != answerCount || header.hash != hash) return false;
+	if (file->Size() < sizeof(PatternHeader) + guessCount * answerCount) return false;
+
+	data = (const uint8_t*)file->Data() + sizeof(PatternHeader);
+	storage = file;
+	return true;
+}
+
+void PatternMatrix::Save(const std::filesystem::path& outpath) const {
+	PatternHeader header;
+	std::memcpy(header.magic, PATTERN_MAGIC, 4);
+	header.version = PATTERN_VERSION;
+	header.wordLength = (uint32_t)wordLen;
+	header.reserved = 0;
+	header.guessCount = guessCount;
+	header.answerCount = answerCount;
+	header.hash = hash;
+
+	// write to a temporary name first so a concurrent reader never maps a
+	// half written cache. The name is unique to this process and call, so
+	// writers filling the same cache each rename a whole file into place.
+	static std::atomic<unsigned> saves{ 0 };
+	auto tmppath = outpath;
+	tmppath += "." + std::to_string(getpid()) + "-" + std::to_string(saves++) + ".tmp";
+	{
+		std::ofstream f{ tmppath, std::ios::binary | std::ios::trunc };
+		if (!f.is_open()) throw std::runtime_error("Failed to open file!");
+
+		f.write((const char*)&header, sizeof(header));
+		f.write((const char*)data, guessCount * answerCount);
+		if (!f) {
+			f.close();
+			std::error_code ignored;
+			std::filesystem::remove(tmppath, ignored);
+			throw std::runtime_error("Failed to write file!");
+		}
+	}
+	std::filesystem::rename(tmppath, outpath);
+}
+
+uint64_t PatternMatrix::HashLists(Dictionary::WordRange guesses, Dictionary::WordRange answers) {
+	// both lists, each terminated by '\0'
+	WordHash h;
+	h.Add(guesses);
+	h.Add('\0');
+	h.Add(answers);
+	h.Add('\0');
+	return h.Value();
+}
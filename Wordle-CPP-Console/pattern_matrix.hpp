@@ -0,0 +1,47 @@
+#ifndef PATTERN_MATRIX_H
+#define PATTERN_MATRIX_H
+
+#include "dictionary.hpp"
+#include "thread_pool.hpp"
+
+#include <stdint.h>
+
+#include <filesystem>
+#include <memory>
+
+// Feedback pattern of every guess against every answer, row major by guess.
+// Patterns are the Feedback base-3 codes, so words are limited to 5 letters
+// to fit a byte.
+class PatternMatrix {
+public:
+	static constexpr size_t MaxLength = 5;
+
+	PatternMatrix(Dictionary::WordRange guesses, Dictionary::WordRange answers, ThreadPool& pool);
+	// Maps the cache file for these lists from cacheDir when there is one,
+	// otherwise computes the matrix and writes it there.
+	PatternMatrix(Dictionary::WordRange guesses, Dictionary::WordRange answers, ThreadPool& pool, const std::filesystem::path& cacheDir);
+	virtual ~PatternMatrix() {}
+
+	void Save(const std::filesystem::path& outpath) const;
+
+	uint8_t At(size_t guess, size_t answer) const { return data[guess * answerCount + answer]; }
+	const uint8_t* Row(size_t guess) const { return data + guess * answerCount; }
+
+	size_t GuessCount() const { return guessCount; }
+	size_t AnswerCount() const { return answerCount; }
+	size_t WordLength() const { return wordLen; }
+	uint64_t Hash() const { return hash; }
+
+	static uint64_t HashLists(Dictionary::WordRange guesses, Dictionary::WordRange answers);
+
+private:
+	void Compute(Dictionary::WordRange guesses, Dictionary::WordRange answers, ThreadPool& pool);
+	bool TryLoad(const std::filesystem::path& filepath);
+
+	std::shared_ptr<const void> storage;
+	const uint8_t* data;
+	size_t guessCount, answerCount, wordLen;
+	uint64_t hash;
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include "renderer.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+
+#ifdef _WIN32
+#include <io.h>
+#define write _write
+#else
+#include <unistd.h>
+#endif
+
+static const std::string_view _formats[] = { "\033[0m", "\033[30;1m", "\033[33;1m", "\033[32;1m" };
+
+Renderer::Renderer(bool incremental)
+	: incremental(incremental), frameLength(0) {}
+
+void Renderer::BeginFrame(size_t len) {
+	frameLength = len;
+	frame.clear();
+	lines.clear();
+}
+
+void Renderer::AddRow(const char* letters, uint32_t pattern) {
+	lines.push_back(frame.size());
+	frame.append(frameLength * 4, '-');
+	frame += '\n';
+
+	lines.push_back(frame.size());
+	for (size_t j = 0; j < frameLength; ++j) {
+		// Feedback results are Grey = 0, Yellow = 1, Green = 2
+		const size_t format = pattern == Board::EmptyRow ? 0 : (size_t)Feedback::At(pattern, j) + 1;
+		frame += "| ";
+		frame += _formats[format];
+		frame += letters[j];
+		frame += _formats[0];
+		frame += ' ';
+	}
+	frame += "|\n";
+}
+
+void Renderer::EndFrame([[maybe_unused]] const std::string& answer, [[maybe_unused]] size_t currentRow) {
+	lines.push_back(frame.size());
+	frame.append(frameLength * 4, '-');
+	frame += '\n';
+#ifdef _DEBUG
+	lines.push_back(frame.size());
+	frame += "Answer is \"" + answer + "\", current row: " + std::to_string(currentRow) + "\n";
+#endif
+	lines.push_back(frame.size());
+}
+
+void Renderer::Present() {
+	if (!incremental) {
+		Emit(frame);
+		return;
+	}
+
+	const size_t count = lines.size() - 1;
+	output.clear();
+	if (previous.size() != count) {
+		// first frame or a different board shape, start from a clear screen
+		output += "\033[H\033[2J";
+		output += frame;
+		previous.resize(count);
+		for (size_t i = 0; i < count; ++i) previous[i].assign(frame, lines[i], lines[i + 1] - lines[i]);
+	}
+	else {
+		for (size_t i = 0; i < count; ++i) {
+			const std::string_view line(frame.data() + lines[i], lines[i + 1] - lines[i]);
+			if (line == previous[i]) continue;
+
+			output += "\033[" + std::to_string(i + 1) + ";1H";
+			output += line;
+			previous[i].assign(line);
+		}
+		// park the cursor under the board and drop the old prompts
+		output += "\033[" + std::to_string(count + 1) + ";1H\033[J";
+	}
+	Emit(output);
+}
+
+void Renderer::Emit(const std::string& data) {
+	// anything still buffered was written before this frame
+	std::cout.flush();
+	std::fflush(stdout);
+
+	const char* p = data.data();
+	size_t left = data.size();
+	while (left > 0) {
+		const auto written = write(1, p, (unsigned int)left);
+		// a signal handler running mid write would otherwise cut the frame
+		// short and leave the incremental diff out of sync with the screen
+		if (written < 0 && errno == EINTR) continue;
+		if (written <= 0) break;
+		p += written;
+		left -= (size_t)written;
+	}
+}
@@ -0,0 +1,55 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include "feedback.hpp"
+#include "wordle_board.hpp"
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+// Draws boards to the terminal. A frame, escapes included, is built in a
+// buffer that is kept between draws and written to stdout with one write.
+// In incremental mode the board is kept at the top of the screen and only
+// the lines that changed since the last frame are rewritten, using cursor
+// movement.
+class Renderer {
+public:
+	Renderer(bool incremental = false);
+	virtual ~Renderer() {}
+
+	// Takes a Board or a FixedBoard
+	template<typename B>
+	void Draw(const B& board) { Render(board); Present(); }
+	// Builds the frame for board without writing it.
+	template<typename B>
+	const std::string& Render(const B& board);
+
+private:
+	void BeginFrame(size_t len);
+	// pattern is Board::EmptyRow for rows without a guess
+	void AddRow(const char* letters, uint32_t pattern);
+	void EndFrame(const std::string& answer, size_t currentRow);
+	void Present();
+	void Emit(const std::string& data);
+
+	bool incremental;
+	size_t frameLength;
+	std::string frame, output;
+	// line start offsets into frame, and the previous frame's lines
+	std::vector<size_t> lines;
+	std::vector<std::string> previous;
+};
+
+template<typename B>
+const std::string& Renderer::Render(const B& board) {
+	BeginFrame(board.GetLength());
+	for (size_t i = 0; i < board.GetAttempts(); ++i) {
+		AddRow(board.GetRowLetters(i), board.GetRowPattern(i));
+	}
+	EndFrame(board.GetAnswer(), board.GetCurrentRow());
+	return frame;
+}
+
+#endif
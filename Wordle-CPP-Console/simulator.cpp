@@ -0,0 +1,130 @@
+#include "simulator.hpp"
+#include "fixed_board.hpp"
+#include "wordle_board.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+std::unique_ptr<Strategy> Strategy::Create(const std::string& name, const PatternMatrix* matrix, Dictionary::WordRange words, ThreadPool& pool) {
+	if (name == "entropy") return std::make_unique<EntropyStrategy>(matrix, words, pool);
+	if (name == "random") return std::make_unique<RandomStrategy>(matrix, words);
+	throw std::invalid_argument("Unknown strategy");
+}
+
+EntropyStrategy::EntropyStrategy(const PatternMatrix* matrix, Dictionary::WordRange words, ThreadPool& pool)
+	: solver(matrix, words), history(0), turn(0) {
+	memo[0] = solver.Rank(1, &pool).front().guess;
+}
+
+size_t EntropyStrategy::NextGuess() {
+	const bool memoize = turn < MaxMemoTurns;
+	if (memoize) {
+		const auto iter = memo.find(history);
+		if (iter != memo.end()) return iter->second;
+	}
+
+	// with two or fewer left, guessing one of them can't do worse
+	const auto& candidates = solver.GetCandidates();
+	const size_t guess = candidates.size() <= 2 ? candidates.front() : solver.Rank(1).front().guess;
+	if (memoize) memo[history] = guess;
+	return guess;
+}
+
+void EntropyStrategy::Update(size_t guess, uint32_t pattern) {
+	solver.Filter(guess, pattern);
+	history = (history << 8) | (pattern + 1);
+	turn++;
+}
+
+RandomStrategy::RandomStrategy(const PatternMatrix* matrix, Dictionary::WordRange words, uint64_t seed)
+	: solver(matrix, words), rng(seed) {}
+
+size_t RandomStrategy::NextGuess() {
+	const auto& candidates = solver.GetCandidates();
+	std::uniform_int_distribution<size_t> dist(0, candidates.size() - 1);
+	return candidates[dist(rng)];
+}
+
+// Plays the games on one board per worker, reset for every answer. B is a
+// FixedBoard for the common lengths so the scoring loops are unrolled.
+template<typename B>
+static SimulationResult simulate_boards(const Strategy& strategy, Dictionary::WordRange words, size_t attempts, ThreadPool& pool, const double* weights) {
+	struct WorkerResult {
+		std::unique_ptr<Strategy> strategy;
+		std::unique_ptr<B> board;
+		std::vector<size_t> distribution;
+		double weight = 0.0, solvedWeight = 0.0, weightedGuesses = 0.0;
+	};
+
+	std::vector<WorkerResult> workers(pool.ThreadCount());
+	for (auto& worker : workers) {
+		worker.strategy = strategy.Clone();
+		worker.distribution.assign(attempts + 1, 0);
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	pool.ParallelFor(words.size(), 4, [&](size_t begin, size_t end, size_t w) {
+		auto& worker = workers[w];
+		if (!worker.board) worker.board.reset(new B((uint8_t)attempts, words[begin]));
+		B& board = *worker.board;
+
+		for (size_t answer = begin; answer < end; ++answer) {
+			board.Reset(words[answer]);
+			worker.strategy->Reset();
+
+			int res;
+			size_t guesses = 0;
+			do {
+				const size_t guess = worker.strategy->NextGuess();
+				res = board.InsertGuess(words[guess]);
+				guesses++;
+				if (res == 0) worker.strategy->Update(guess, board.GetLastPattern());
+			} while (res == 0);
+
+			worker.distribution[res == 1 ? guesses : 0]++;
+
+			const double weight = weights ? weights[answer] : 1.0;
+			worker.weight += weight;
+			if (res == 1) {
+				worker.solvedWeight += weight;
+				worker.weightedGuesses += weight * guesses;
+			}
+		}
+		});
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+
+	SimulationResult result{};
+	result.games = words.size();
+	result.seconds = std::chrono::duration<double>(elapsed).count();
+	result.distribution.assign(attempts + 1, 0);
+	double weight = 0.0, solvedWeight = 0.0, weightedGuesses = 0.0;
+	for (const auto& worker : workers) {
+		for (size_t n = 0; n <= attempts; ++n) result.distribution[n] += worker.distribution[n];
+		weight += worker.weight;
+		solvedWeight += worker.solvedWeight;
+		weightedGuesses += worker.weightedGuesses;
+	}
+	result.weightedAverageGuesses = solvedWeight > 0.0 ? weightedGuesses / solvedWeight : 0.0;
+	result.weightedSolveRate = weight > 0.0 ? solvedWeight / weight : 0.0;
+
+	size_t total = 0;
+	for (size_t n = 1; n <= attempts; ++n) {
+		result.solved += result.distribution[n];
+		total += n * result.distribution[n];
+		if (result.distribution[n]) result.maxGuesses = n;
+	}
+	result.averageGuesses = result.solved ? (double)total / result.solved : 0.0;
+	return result;
+}
+
+SimulationResult simulate(const Strategy& strategy, Dictionary::WordRange words, size_t attempts, ThreadPool& pool, const double* weights) {
+	switch (words.empty() ? 0 : words[0].length()) {
+	case 4: return simulate_boards<FixedBoard<4>>(strategy, words, attempts, pool, weights);
+	case 5: return simulate_boards<FixedBoard<5>>(strategy, words, attempts, pool, weights);
+	case 6: return simulate_boards<FixedBoard<6>>(strategy, words, attempts, pool, weights);
+	case 7: return simulate_boards<FixedBoard<7>>(strategy, words, attempts, pool, weights);
+	case 8: return simulate_boards<FixedBoard<8>>(strategy, words, attempts, pool, weights);
+	default: return simulate_boards<Board>(strategy, words, attempts, pool, weights);
+	}
+}
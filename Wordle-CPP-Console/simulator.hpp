@@ -0,0 +1,83 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include "pattern_matrix.hpp"
+#include "solver.hpp"
+#include "thread_pool.hpp"
+
+#include <stdint.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A guessing strategy for headless games. Guesses are indexes into the word
+// list the strategy was built over. The simulator clones one instance per
+// worker thread, so implementations don't need to be thread safe.
+class Strategy {
+public:
+	virtual ~Strategy() {}
+
+	virtual std::unique_ptr<Strategy> Clone() const = 0;
+	virtual void Reset() = 0;
+	virtual size_t NextGuess() = 0;
+	virtual void Update(size_t guess, uint32_t pattern) = 0;
+
+	static std::unique_ptr<Strategy> Create(const std::string& name, const PatternMatrix* matrix, Dictionary::WordRange words, ThreadPool& pool);
+};
+
+// Plays the highest entropy guess every turn. The strategy is deterministic,
+// so the guess only depends on the feedback seen so far and is memoized by
+// that history. Every game shares the opener, most share the second guess.
+class EntropyStrategy : public Strategy {
+public:
+	EntropyStrategy(const PatternMatrix* matrix, Dictionary::WordRange words, ThreadPool& pool);
+
+	std::unique_ptr<Strategy> Clone() const override { return std::make_unique<EntropyStrategy>(*this); }
+	void Reset() override { solver.Reset(); history = 0; turn = 0; }
+	size_t NextGuess() override;
+	void Update(size_t guess, uint32_t pattern) override;
+
+private:
+	// patterns fit a byte, so a uint64_t holds 8 turns of history
+	static constexpr size_t MaxMemoTurns = 8;
+
+	Solver solver;
+	std::unordered_map<uint64_t, size_t> memo;
+	uint64_t history;
+	size_t turn;
+};
+
+// Plays a random word that is still consistent with the feedback.
+class RandomStrategy : public Strategy {
+public:
+	RandomStrategy(const PatternMatrix* matrix, Dictionary::WordRange words, uint64_t seed = 0);
+
+	std::unique_ptr<Strategy> Clone() const override { return std::make_unique<RandomStrategy>(*this); }
+	void Reset() override { solver.Reset(); }
+	size_t NextGuess() override;
+	void Update(size_t guess, uint32_t pattern) override { solver.Filter(guess, pattern); }
+
+private:
+	Solver solver;
+	std::mt19937_64 rng;
+};
+
+struct SimulationResult {
+	size_t games, solved, maxGuesses;
+	double averageGuesses, seconds;
+	// averages over answers drawn by weight, like the game does, and equal
+	// to the plain ones without weights
+	double weightedAverageGuesses, weightedSolveRate;
+	// distribution[n] is the number of games solved in n guesses, games that
+	// ran out of attempts are counted in distribution[0]
+	std::vector<size_t> distribution;
+};
+
+// Plays one game per answer on pool. Answers are indexes into the strategy's
+// word list. weights, from Dictionary::WeightsOfLength, can be null.
+SimulationResult simulate(const Strategy& strategy, Dictionary::WordRange words, size_t attempts, ThreadPool& pool, const double* weights = nullptr);
+
+#endif
@@ -0,0 +1,91 @@
+#include "solver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#define PATTERN_COUNT 256
+
+Solver::Solver(const PatternMatrix* matrix, Dictionary::WordRange guesses)
+	: matrix(matrix), guesses(guesses), hardMode(false) {
+	if (guesses.size() != matrix->GuessCount()) throw std::invalid_argument("Guess list doesn't match the pattern matrix");
+
+	auto table = std::make_shared<std::vector<double>>(matrix->AnswerCount() + 1, 0.0);
+	for (size_t c = 2; c < table->size(); ++c) (*table)[c] = c * std::log2((double)c);
+	countLog = table;
+
+	Reset();
+}
+
+void Solver::Reset() {
+	candidates.resize(matrix->AnswerCount());
+	for (size_t i = 0; i < candidates.size(); ++i) candidates[i] = (uint32_t)i;
+	isCandidate.assign(matrix->AnswerCount(), 1);
+}
+
+void Solver::Filter(size_t guess, uint32_t pattern) {
+	const uint8_t* row = matrix->Row(guess);
+	const auto end = std::remove_if(candidates.begin(), candidates.end(), [this, row, pattern](uint32_t answer) {
+		if (row[answer] == pattern) return false;
+		isCandidate[answer] = 0;
+		return true;
+		});
+	candidates.erase(end, candidates.end());
+}
+
+double Solver::Entropy(size_t guess, uint32_t* histogram) const {
+	if (candidates.empty()) return 0.0;
+
+	const uint8_t* row = matrix->Row(guess);
+	for (uint32_t answer : candidates) histogram[row[answer]]++;
+
+	// H = log2(n) - sum(c * log2(c)) / n, with c * log2(c) from a table.
+	// Clearing as we go leaves the histogram zeroed for the next guess.
+	const double* table = countLog->data();
+	double sum = 0.0;
+	for (size_t p = 0; p < PATTERN_COUNT; ++p) {
+		sum += table[histogram[p]];
+		histogram[p] = 0;
+	}
+	const double n = (double)candidates.size();
+	return std::log2(n) - sum / n;
+}
+
+std::vector<Solver::Ranked> Solver::Rank(size_t count, ThreadPool* pool) const {
+	// answers and guesses are the same words when the matrix is square
+	const bool square = matrix->GuessCount() == matrix->AnswerCount();
+	const bool candidatesOnly = hardMode && square;
+	std::vector<Ranked> ranked(candidatesOnly ? candidates.size() : matrix->GuessCount());
+
+	const auto rankRange = [this, &ranked, candidatesOnly](size_t begin, size_t end, uint32_t* histogram) {
+		for (size_t i = begin; i < end; ++i) {
+			const size_t g = candidatesOnly ? candidates[i] : i;
+			ranked[i] = { g, Entropy(g, histogram) };
+		}
+	};
+
+	if (pool) {
+		std::vector<uint32_t> histograms(pool->ThreadCount() * PATTERN_COUNT, 0);
+		pool->ParallelFor(ranked.size(), 64, [&](size_t begin, size_t end, size_t worker) {
+			rankRange(begin, end, histograms.data() + worker * PATTERN_COUNT);
+			});
+	} else {
+		uint32_t histogram[PATTERN_COUNT] = {};
+		rankRange(0, ranked.size(), histogram);
+	}
+
+	count = std::min(count, ranked.size());
+	std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end(), [this, square](const Ranked& a, const Ranked& b) {
+		if (a.entropy != b.entropy) return a.entropy > b.entropy;
+		if (square && isCandidate[a.guess] != isCandidate[b.guess]) return isCandidate[a.guess] > isCandidate[b.guess];
+		return a.guess < b.guess;
+		});
+	ranked.resize(count);
+	return ranked;
+}
+
+std::optional<size_t> Solver::GuessIndex(std::string_view word) const {
+	const auto iter = std::find(guesses.begin(), guesses.end(), word);
+	if (iter == guesses.end()) return std::nullopt;
+	return iter - guesses.begin();
+}
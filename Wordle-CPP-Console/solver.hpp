@@ -0,0 +1,55 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "pattern_matrix.hpp"
+#include "thread_pool.hpp"
+
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// Ranks guesses by the expected information they give about the answer,
+// given the feedback seen so far. Guesses and answers are the rows and
+// columns of a PatternMatrix.
+class Solver {
+public:
+	struct Ranked {
+		size_t guess;
+		double entropy;
+	};
+
+	Solver(const PatternMatrix* matrix, Dictionary::WordRange guesses);
+	virtual ~Solver() {}
+
+	void Reset();
+	// In hard mode every guess has to be able to be the answer, so Rank only
+	// considers the candidates. Needs guesses and answers to be the same list.
+	void SetHardMode(bool hard) { hardMode = hard; }
+	// Drops every candidate answer that wouldn't have produced pattern.
+	void Filter(size_t guess, uint32_t pattern);
+
+	// Best count guesses, highest entropy first. Ties prefer guesses that
+	// can still be the answer. Runs on pool when one is given.
+	std::vector<Ranked> Rank(size_t count, ThreadPool* pool = nullptr) const;
+	// histogram must hold 256 zeroed counters and is left zeroed
+	double Entropy(size_t guess, uint32_t* histogram) const;
+
+	std::optional<size_t> GuessIndex(std::string_view word) const;
+	std::string_view GetGuess(size_t i) const { return guesses[i]; }
+	const std::vector<uint32_t>& GetCandidates() const { return candidates; }
+
+private:
+	const PatternMatrix* matrix;
+	Dictionary::WordRange guesses;
+	std::vector<uint32_t> candidates;
+	// candidates as a flag per answer, for tie breaking
+	std::vector<uint8_t> isCandidate;
+	bool hardMode;
+	// c * log2(c) for every possible pattern count c, shared between copies
+	std::shared_ptr<const std::vector<double>> countLog;
+};
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef STATIC_DICTIONARY_H
+#define STATIC_DICTIONARY_H
+
+#include <stdint.h>
+
+#include <array>
+#include <cstddef>
+
+// Builds the compiled dictionary format at compile time from a newline
+// separated word list, so a list generated into a header turns into an image
+// Dictionary(const void*, size_t) can view without sorting or parsing:
+//
+//   constexpr char words[] = "slate\ncrane\n";
+//   constexpr auto index = StaticDictionary::Sort<StaticDictionary::CountLines(words)>(words);
+//   constexpr auto image = StaticDictionary::Compile<StaticDictionary::ImageSize(index)>(index);
+//
+// Lines that aren't all ASCII letters are skipped. Sorting is an insertion
+// sort, which is linear for the already sorted lists wordle-dict generates
+// but quadratic for shuffled ones, so keep hand written lists short.
+//
+// Compilers memoize constexpr calls and are slow to evaluate library code, so
+// the loops index raw char arrays and don't call helpers per letter.
+class StaticDictionary {
+public:
+	// Layout shared with dictionary.cpp, which checks it against its structs
+	static constexpr uint32_t Version = 2;
+	static constexpr uint32_t FlagAlphabetized = 0b1 << 0;
+	static constexpr size_t HeaderSize = 24;
+	static constexpr size_t BucketSize = 16;
+
+	// Words as offsets into the text
+	template<size_t N>
+	struct Index {
+		const char* text = nullptr;
+		std::array<uint32_t, N> offsets{};
+		std::array<uint32_t, N> lengths{};
+		size_t count = 0;
+		size_t maxLength = 0;
+	};
+
+	template<size_t Size>
+	static constexpr size_t CountLines(const char (&text)[Size]) {
+		size_t count = 1;
+		for (size_t i = 0; i < Size; ++i) {
+			if (text[i] == '\n') count++;
+		}
+		return count;
+	}
+
+	// Words sorted by length then alphabetically, without duplicates. N has
+	// to be at least the number of lines in text.
+	template<size_t N, size_t Size>
+	static constexpr Index<N> Sort(const char (&text)[Size]) {
+		Index<N> index;
+		index.text = text;
+
+		// Size counts the terminating null
+		size_t pos = 0;
+		while (pos < Size - 1) {
+			const size_t start = pos;
+			while (pos < Size - 1 && text[pos] != '\n') pos++;
+			size_t len = pos - start;
+			if (len > 0 && text[pos - 1] == '\r') len--;
+			pos++;
+
+			bool letters = len > 0;
+			for (size_t k = start; letters && k < start + len; ++k) {
+				const char c = text[k];
+				letters = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+			}
+			if (!letters) continue;
+
+			// compare against the last word first, sorted input stops there
+			size_t i = index.count;
+			int order = 1;
+			while (i > 0) {
+				const size_t other = index.offsets[i - 1], otherLen = index.lengths[i - 1];
+				order = len < otherLen ? -1 : len > otherLen ? 1 : 0;
+				for (size_t k = 0; order == 0 && k < len; ++k) {
+					const unsigned char a = text[start + k], b = text[other + k];
+					order = a < b ? -1 : a > b ? 1 : 0;
+				}
+				if (order >= 0) break;
+				index.offsets[i] = index.offsets[i - 1];
+				index.lengths[i] = index.lengths[i - 1];
+				i--;
+			}
+			if (order == 0) {
+				// duplicate of the word before i, close the gap again
+				for (; i < index.count; ++i) {
+					index.offsets[i] = index.offsets[i + 1];
+					index.lengths[i] = index.lengths[i + 1];
+				}
+				continue;
+			}
+			index.offsets[i] = (uint32_t)start;
+			index.lengths[i] = (uint32_t)len;
+			index.count++;
+			if (len > index.maxLength) index.maxLength = len;
+		}
+		return index;
+	}
+
+	template<size_t N>
+	static constexpr size_t ImageSize(const Index<N>& index) {
+		size_t size = HeaderSize + (index.maxLength + 1) * BucketSize;
+		for (size_t i = 0; i < index.count; ++i) size += index.lengths[i];
+		return size;
+	}
+
+	template<size_t Size, size_t N>
+	static constexpr std::array<unsigned char, Size> Compile(const Index<N>& index) {
+		std::array<unsigned char, Size> image{};
+		image[0] = 'W'; image[1] = 'D'; image[2] = 'C'; image[3] = 'T';
+		Put(image, 4, Version, 4);
+		Put(image, 8, FlagAlphabetized, 4);
+		Put(image, 12, index.maxLength, 4);
+		Put(image, 16, index.count, 8);
+
+		const char* text = index.text;
+		size_t offset = HeaderSize + (index.maxLength + 1) * BucketSize;
+		size_t i = 0;
+		for (size_t len = 0; len <= index.maxLength; ++len) {
+			const size_t first = i;
+			for (; i < index.count && index.lengths[i] == len; ++i) {
+				const size_t start = index.offsets[i];
+				for (size_t k = 0; k < len; ++k) image[offset++] = (unsigned char)text[start + k];
+			}
+			Put(image, HeaderSize + len * BucketSize, i == first ? 0 : offset - (i - first) * len, 8);
+			Put(image, HeaderSize + len * BucketSize + 8, i - first, 8);
+		}
+		return image;
+	}
+
+private:
+	// The format is in native byte order
+	template<size_t Size>
+	static constexpr void Put(std::array<unsigned char, Size>& image, size_t pos, uint64_t value, size_t bytes) {
+		for (size_t i = 0; i < bytes; ++i) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+			image[pos + bytes - 1 - i] = (unsigned char)(value >> (i * 8));
+#else
+			image[pos + i] = (unsigned char)(value >> (i * 8));
+#endif
+		}
+	}
+};
+
+#endif
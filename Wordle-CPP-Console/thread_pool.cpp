@@ -0,0 +1,73 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threads)
+	: job(nullptr), jobCount(0), jobGrain(1), generation(0), busy(0), next(0), stopping(false) {
+	if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+	for (size_t i = 1; i < threads; ++i) {
+		workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (auto& t : workers) t.join();
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t grain, const RangeFn& fn) {
+	if (count == 0) return;
+	if (grain == 0) grain = 1;
+
+	if (workers.empty() || count <= grain) {
+		fn(0, count, 0);
+		return;
+	}
+
+	std::lock_guard<std::mutex> serial(loopLock);
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		job = &fn;
+		jobCount = count;
+		jobGrain = grain;
+		next = 0;
+		busy = workers.size();
+		generation++;
+	}
+	wake.notify_all();
+
+	RunChunks(0);
+
+	std::unique_lock<std::mutex> guard(lock);
+	done.wait(guard, [this] { return busy == 0; });
+	job = nullptr;
+}
+
+void ThreadPool::RunChunks(size_t worker) {
+	size_t begin;
+	while ((begin = next.fetch_add(jobGrain)) < jobCount) {
+		(*job)(begin, std::min(begin + jobGrain, jobCount), worker);
+	}
+}
+
+void ThreadPool::WorkerLoop(size_t worker) {
+	size_t seen = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			wake.wait(guard, [this, seen] { return stopping || generation != seen; });
+			if (stopping) return;
+			seen = generation;
+		}
+
+		RunChunks(worker);
+
+		std::lock_guard<std::mutex> guard(lock);
+		if (--busy == 0) done.notify_one();
+	}
+}
@@ -0,0 +1,47 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data parallel loops. The calling thread
+// takes part in every loop, so a pool of N threads has N - 1 workers.
+class ThreadPool {
+public:
+	typedef std::function<void(size_t begin, size_t end, size_t worker)> RangeFn;
+
+	ThreadPool(size_t threads = 0);
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	virtual ~ThreadPool();
+
+	size_t ThreadCount() const { return workers.size() + 1; }
+
+	// Calls fn over [0, count) in chunks of at most grain items and returns
+	// once all of them ran. Chunks are claimed dynamically, so uneven chunks
+	// balance out. worker is in [0, ThreadCount()) and identifies the thread,
+	// for indexing per-thread scratch space. Loops from several threads are
+	// run one after the other.
+	void ParallelFor(size_t count, size_t grain, const RangeFn& fn);
+
+private:
+	void WorkerLoop(size_t worker);
+	void RunChunks(size_t worker);
+
+	std::vector<std::thread> workers;
+	std::mutex loopLock;
+
+	std::mutex lock;
+	std::condition_variable wake, done;
+	const RangeFn* job;
+	size_t jobCount, jobGrain, generation, busy;
+	std::atomic<size_t> next;
+	bool stopping;
+};
+
+#endif
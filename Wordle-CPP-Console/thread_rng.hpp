@@ -0,0 +1,18 @@
+#ifndef THREAD_RNG_H
+#define THREAD_RNG_H
+
+#include <random>
+
+// Random engine of the calling thread, seeded from std::random_device the
+// first time each thread uses it. Threads never share generator state, unlike
+// rand().
+inline std::mt19937_64& thread_rng() {
+	thread_local std::mt19937_64 rng = [] {
+		std::random_device device;
+		std::seed_seq seed{ device(), device(), device(), device() };
+		return std::mt19937_64(seed);
+	}();
+	return rng;
+}
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef WORD_HASH_H
+#define WORD_HASH_H
+
+#include "dictionary.hpp"
+
+#include <stdint.h>
+
+// FNV-1a over word lists, identifying the list a cache or schedule file was
+// built from. The values are stored in those files, so they must not change.
+class WordHash {
+public:
+	void Add(char c) { h = (h ^ (unsigned char)c) * 0x100000001b3ull; }
+
+	// Every word followed by '\n'
+	void Add(Dictionary::WordRange words) {
+		for (const auto& word : words) {
+			for (char c : word) Add(c);
+			Add('\n');
+		}
+	}
+
+	uint64_t Value() const { return h; }
+
+private:
+	uint64_t h = 0xcbf29ce484222325ull;
+};
+
+#endif
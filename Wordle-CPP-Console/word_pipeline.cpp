@@ -0,0 +1,589 @@
+#include "word_pipeline.hpp"
+#include "char_class.hpp"
+#include "dictionary.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#define BLOCK_SIZE (1 << 20)
+#define QUEUE_BLOCKS 4
+// longest partial line the reader carries between blocks, a 255 letter word
+// and a count column. Longer lines couldn't be kept and are skipped unread.
+#define MAX_LINE_LENGTH (UINT8_MAX + 64)
+// run files merged at once, more take several passes
+#define MERGE_WAYS 64
+
+// Blocks handed from one stage to the next. Push waits while the queue is
+// full, which is what bounds memory while a later stage is busy.
+class BlockQueue {
+public:
+	BlockQueue(size_t capacity) : capacity(capacity), closed(false) {}
+
+	// false once the queue is closed, the block is dropped then
+	bool Push(std::string&& block) {
+		std::unique_lock<std::mutex> guard(lock);
+		changed.wait(guard, [this] { return closed || blocks.size() < capacity; });
+		if (closed) return false;
+		blocks.push_back(std::move(block));
+		changed.notify_all();
+		return true;
+	}
+
+	// false once the queue is closed and empty
+	bool Pop(std::string& block) {
+		std::unique_lock<std::mutex> guard(lock);
+		changed.wait(guard, [this] { return closed || !blocks.empty(); });
+		if (blocks.empty()) return false;
+		block = std::move(blocks.front());
+		blocks.pop_front();
+		changed.notify_all();
+		return true;
+	}
+
+	void Close() {
+		std::lock_guard<std::mutex> guard(lock);
+		closed = true;
+		changed.notify_all();
+	}
+
+private:
+	std::mutex lock;
+	std::condition_variable changed;
+	std::deque<std::string> blocks;
+	size_t capacity;
+	bool closed;
+};
+
+// True if column, the rest of a line after its word, is whitespace and a
+// count with nothing but whitespace after it, like Dictionary's weights
+static bool _parse_count(std::string_view column, uint64_t& count) {
+	size_t i = 0;
+	while (i < column.length() && (column[i] == ' ' || column[i] == '\t')) i++;
+	if (i == 0 || i == column.length() || column[i] < '0' || column[i] > '9') return false;
+
+	count = 0;
+	for (; i < column.length() && column[i] >= '0' && column[i] <= '9'; ++i) {
+		const uint64_t digit = column[i] - '0';
+		if (count > (UINT64_MAX - digit) / 10) return false;
+		count = count * 10 + digit;
+	}
+	while (i < column.length() && (column[i] == ' ' || column[i] == '\t')) i++;
+	return i == column.length();
+}
+
+// Records between the filter and sort stages and in run files are a length
+// byte, the word and a native order 64 bit count
+static void _append_record(std::string& out, std::string_view word, uint64_t count) {
+	out.push_back((char)(uint8_t)word.length());
+	out.append(word.data(), word.length());
+	out.append((const char*)&count, sizeof(count));
+}
+
+// Words of the input in sorted runs, the last one in memory and the others
+// spilled to temporary files once they filled the budget
+class WordPipeline::SortedRuns {
+public:
+	SortedRuns(size_t budget, const std::filesystem::path& tempDir)
+		: budget(budget), tempDir(tempDir) {
+		prefix = "wordle-dict-" + std::to_string((uintptr_t)this) + "-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+	}
+	SortedRuns(const SortedRuns&) = delete;
+	SortedRuns& operator=(const SortedRuns&) = delete;
+
+	virtual ~SortedRuns() {
+		std::error_code ignored;
+		for (const auto& file : files) std::filesystem::remove(file, ignored);
+	}
+
+	void Add(std::string_view word, uint64_t count) {
+		entries.push_back({ arena.size(), count, (uint32_t)word.length() });
+		arena.append(word.data(), word.length());
+		if (arena.size() + entries.size() * sizeof(Entry) >= budget) Spill();
+	}
+
+	// Sorts what's left in memory, spilling it too if earlier runs were.
+	// Merges groups of run files until a single pass can merge the rest.
+	void Finish() {
+		SortEntries();
+		if (!files.empty() && !entries.empty()) Spill();
+
+		while (files.size() > MERGE_WAYS) {
+			std::vector<std::filesystem::path> merged;
+			for (size_t i = 0; i < files.size(); i += MERGE_WAYS) {
+				const std::vector<std::filesystem::path> group(files.begin() + i, files.begin() + std::min(i + MERGE_WAYS, files.size()));
+				merged.push_back(tempDir / (prefix + "-" + std::to_string(spilled++) + ".run"));
+
+				Cursor cursor(group, nullptr);
+				RunWriter out(merged.back());
+				while (cursor.Next()) out.Write(cursor.Word(), cursor.Count());
+				out.Finish();
+
+				std::error_code ignored;
+				for (const auto& file : group) std::filesystem::remove(file, ignored);
+			}
+			files.swap(merged);
+		}
+	}
+
+	size_t SpilledRuns() const { return spilled; }
+
+	// Walks the merged runs in order, once per distinct word
+	class Cursor {
+	public:
+		Cursor(const SortedRuns& runs) : Cursor(runs.files, runs.files.empty() ? &runs : nullptr) {}
+
+		// Merges files, or walks the in memory run of memory
+		Cursor(const std::vector<std::filesystem::path>& files, const SortedRuns* memory) : memory(memory), memoryPos(0) {
+			for (const auto& file : files) {
+				auto reader = std::make_unique<Reader>();
+				reader->file.open(file, std::ios::binary);
+				if (!reader->file.is_open()) throw std::runtime_error("Failed to open run file!");
+				if (reader->Next()) readers.push_back(std::move(reader));
+			}
+			std::make_heap(readers.begin(), readers.end(), HeapOrder);
+		}
+
+		bool Next() {
+			if (memory) {
+				if (memoryPos >= memory->entries.size()) return false;
+				const auto& entry = memory->entries[memoryPos++];
+				word.assign(memory->arena.data() + entry.offset, entry.length);
+				count = entry.count;
+				return true;
+			}
+
+			if (readers.empty()) return false;
+			word = readers.front()->word;
+			count = 0;
+			while (!readers.empty() && readers.front()->word == word) {
+				count += readers.front()->count;
+				std::pop_heap(readers.begin(), readers.end(), HeapOrder);
+				if (readers.back()->Next()) std::push_heap(readers.begin(), readers.end(), HeapOrder);
+				else readers.pop_back();
+			}
+			return true;
+		}
+
+		std::string_view Word() const { return word; }
+		uint64_t Count() const { return count; }
+
+	private:
+		struct Reader {
+			std::ifstream file;
+			std::string word;
+			uint64_t count = 0;
+
+			bool Next() {
+				int len = file.get();
+				if (len == EOF) return false;
+				word.resize(len);
+				file.read(word.data(), len);
+				file.read((char*)&count, sizeof(count));
+				if (!file) throw std::runtime_error("Truncated run file!");
+				return true;
+			}
+		};
+
+		// std heaps keep the largest element in front
+		static bool HeapOrder(const std::unique_ptr<Reader>& a, const std::unique_ptr<Reader>& b) {
+			return Dictionary::WordOrder(b->word, a->word);
+		}
+
+		const SortedRuns* memory;
+		std::vector<std::unique_ptr<Reader>> readers;
+		size_t memoryPos;
+		std::string word;
+		uint64_t count;
+	};
+
+private:
+	struct Entry {
+		uint64_t offset;
+		uint64_t count;
+		uint32_t length;
+	};
+
+	std::string_view View(const Entry& entry) const { return { arena.data() + entry.offset, entry.length }; }
+
+	// sorts the entries and merges duplicates into the first of them
+	void SortEntries() {
+		std::sort(entries.begin(), entries.end(), [this](const Entry& a, const Entry& b) {
+			return Dictionary::WordOrder(View(a), View(b));
+			});
+
+		size_t out = 0;
+		for (size_t i = 0; i < entries.size(); ++i) {
+			if (out > 0 && View(entries[out - 1]) == View(entries[i])) entries[out - 1].count += entries[i].count;
+			else entries[out++] = entries[i];
+		}
+		entries.resize(out);
+	}
+
+	class RunWriter {
+	public:
+		RunWriter(const std::filesystem::path& path) : f(path, std::ios::binary | std::ios::trunc) {
+			if (!f.is_open()) throw std::runtime_error("Failed to create run file!");
+		}
+
+		void Write(std::string_view word, uint64_t count) {
+			_append_record(block, word, count);
+			if (block.size() >= BLOCK_SIZE) {
+				f.write(block.data(), block.size());
+				block.clear();
+			}
+		}
+
+		void Finish() {
+			f.write(block.data(), block.size());
+			f.close();
+			if (!f) throw std::runtime_error("Failed to write run file!");
+		}
+
+	private:
+		std::ofstream f;
+		std::string block;
+	};
+
+	void Spill() {
+		SortEntries();
+
+		files.push_back(tempDir / (prefix + "-" + std::to_string(spilled++) + ".run"));
+		RunWriter out(files.back());
+		for (const auto& entry : entries) out.Write(View(entry), entry.count);
+		out.Finish();
+
+		arena.clear();
+		entries.clear();
+	}
+
+	size_t budget;
+	std::filesystem::path tempDir;
+	std::string prefix;
+	std::vector<std::filesystem::path> files;
+	size_t spilled = 0;
+	std::string arena;
+	std::vector<Entry> entries;
+};
+
+// Writes the merged words in one of the output formats
+class ListWriter {
+public:
+	ListWriter(const std::filesystem::path& output, WordPipeline::Format format, bool counts, const std::filesystem::path& tempDir)
+		: output(output), format(format), counts(counts), words(0) {
+		// the bucket table comes first in compiled dictionaries, so packed
+		// words go to a temporary file until their counts are known, and
+		// counts to another one as the weights that follow the words
+		const std::string prefix = output.filename().string() + "." + std::to_string((uintptr_t)this);
+		path = format == WordPipeline::Format::BINARY ? tempDir / (prefix + ".words") : output;
+		f.open(path, std::ios::binary | std::ios::trunc);
+		if (!f.is_open()) throw std::runtime_error("Failed to open file!");
+		if (format == WordPipeline::Format::BINARY && counts) {
+			weightsPath = tempDir / (prefix + ".weights");
+			weights.open(weightsPath, std::ios::binary | std::ios::trunc);
+			if (!weights.is_open()) throw std::runtime_error("Failed to open file!");
+		}
+		if (format == WordPipeline::Format::HEADER) {
+			f << "// Generated by wordle-dict, do not edit.\n";
+			f << "#ifndef EMBEDDED_WORDS_H\n#define EMBEDDED_WORDS_H\n\n";
+			f << "constexpr char wordle_embedded_words[] =\n";
+		}
+	}
+
+	virtual ~ListWriter() {
+		if (format == WordPipeline::Format::BINARY) {
+			f.close();
+			if (weights.is_open()) weights.close();
+			std::error_code ignored;
+			std::filesystem::remove(path, ignored);
+			if (!weightsPath.empty()) std::filesystem::remove(weightsPath, ignored);
+		}
+	}
+
+	void Write(std::string_view word, uint64_t count) {
+		switch (format) {
+		case WordPipeline::Format::BINARY:
+			if (word.length() >= lengthCounts.size()) lengthCounts.resize(word.length() + 1);
+			lengthCounts[word.length()]++;
+			block.append(word.data(), word.length());
+			if (counts) {
+				const double weight = (double)count;
+				weightBlock.append((const char*)&weight, sizeof(weight));
+			}
+			break;
+		case WordPipeline::Format::TEXT:
+			block.append(word.data(), word.length());
+			if (counts) block += " " + std::to_string(count);
+			block.push_back('\n');
+			break;
+		case WordPipeline::Format::HEADER:
+			block += "\t\"";
+			block.append(word.data(), word.length());
+			block += "\\n\"\n";
+			break;
+		}
+		words++;
+		if (block.size() >= BLOCK_SIZE) Flush();
+	}
+
+	size_t Finish() {
+		if (format == WordPipeline::Format::HEADER) {
+			if (words == 0) block += "\t\"\"";
+			block += ";\n\n#endif\n";
+		}
+		Flush();
+		f.close();
+		if (weights.is_open()) weights.close();
+		if (!f || !weights) throw std::runtime_error("Failed to write file!");
+
+		if (format == WordPipeline::Format::BINARY) {
+			std::ofstream out{ output, std::ios::binary | std::ios::trunc };
+			if (!out.is_open()) throw std::runtime_error("Failed to open file!");
+			const std::string header = Dictionary::CompiledHeader(lengthCounts, true, counts);
+			out.write(header.data(), header.size());
+
+			std::vector<char> buf(BLOCK_SIZE);
+			const auto copy = [&](const std::filesystem::path& from) {
+				std::ifstream in{ from, std::ios::binary };
+				while (in.read(buf.data(), buf.size()) || in.gcount() > 0) {
+					out.write(buf.data(), in.gcount());
+				}
+			};
+			copy(path);
+			if (counts) {
+				size_t letters = 0;
+				for (size_t len = 0; len < lengthCounts.size(); ++len) letters += len * lengthCounts[len];
+				const uint64_t zero = 0;
+				out.write((const char*)&zero, Dictionary::WeightPadding(letters));
+				copy(weightsPath);
+			}
+			if (!out) throw std::runtime_error("Failed to write file!");
+		}
+		return words;
+	}
+
+private:
+	void Flush() {
+		f.write(block.data(), block.size());
+		block.clear();
+		if (weights.is_open()) weights.write(weightBlock.data(), weightBlock.size());
+		weightBlock.clear();
+	}
+
+	std::filesystem::path output, path, weightsPath;
+	WordPipeline::Format format;
+	bool counts;
+	std::ofstream f, weights;
+	std::string block, weightBlock;
+	std::vector<uint64_t> lengthCounts;
+	size_t words;
+};
+
+WordPipeline::WordPipeline(const Options& options)
+	: options(options) {
+	if (this->options.tempDir.empty()) this->options.tempDir = std::filesystem::temp_directory_path();
+	if (this->options.memoryBudget < BLOCK_SIZE) this->options.memoryBudget = BLOCK_SIZE;
+}
+
+WordPipeline::Stats WordPipeline::Run(const std::string& input, const std::filesystem::path& output, Format format) {
+	Stats stats;
+	const bool join = !options.frequencies.empty();
+	const size_t budget = join ? options.memoryBudget / 2 : options.memoryBudget;
+
+	SortedRuns words(budget, options.tempDir);
+	Sort(input, words, stats);
+	stats.spilledRuns = words.SpilledRuns();
+
+	std::unique_ptr<SortedRuns> frequencies;
+	if (join) {
+		Stats frequencyStats;
+		frequencies = std::make_unique<SortedRuns>(budget, options.tempDir);
+		Sort(options.frequencies.string(), *frequencies, frequencyStats);
+		stats.spilledRuns += frequencies->SpilledRuns();
+	}
+
+	ListWriter writer(output, format, join, options.tempDir);
+	SortedRuns::Cursor wordCursor(words);
+	if (join) {
+		// merge join of two sorted streams
+		SortedRuns::Cursor countCursor(*frequencies);
+		bool more = wordCursor.Next() && countCursor.Next();
+		while (more) {
+			if (Dictionary::WordOrder(wordCursor.Word(), countCursor.Word())) {
+				more = wordCursor.Next();
+			} else if (Dictionary::WordOrder(countCursor.Word(), wordCursor.Word())) {
+				more = countCursor.Next();
+			} else {
+				if (countCursor.Count() >= options.minCount) writer.Write(wordCursor.Word(), countCursor.Count());
+				more = wordCursor.Next() && countCursor.Next();
+			}
+		}
+	} else {
+		while (wordCursor.Next()) {
+			if (wordCursor.Count() >= options.minCount) writer.Write(wordCursor.Word(), wordCursor.Count());
+		}
+	}
+	stats.words = writer.Finish();
+	return stats;
+}
+
+void WordPipeline::Sort(const std::string& input, SortedRuns& runs, Stats& stats) const {
+	std::ifstream file;
+	std::istream* in = &std::cin;
+	if (input != "-") {
+		file.open(input, std::ios::binary);
+		if (!file.is_open()) throw std::runtime_error("Failed to open " + input);
+		in = &file;
+	}
+
+	BlockQueue lines(QUEUE_BLOCKS), records(QUEUE_BLOCKS);
+	std::exception_ptr readError, filterError;
+	size_t lineCount = 0, rejected = 0, overlong = 0;
+
+	// newline aligned blocks of the input
+	std::thread reader([&] {
+		try {
+			std::string carry;
+			bool first = true, skipping = false;
+			while (true) {
+				std::string block = std::move(carry);
+				const size_t used = block.size();
+				block.resize(used + BLOCK_SIZE);
+				in->read(block.data() + used, BLOCK_SIZE);
+				block.resize(used + in->gcount());
+
+				if (first && block.size() >= 4 && std::memcmp(block.data(), "WDCT", 4) == 0) throw std::runtime_error("Input is already a compiled dictionary");
+				first = false;
+
+				if (in->gcount() == 0) {
+					if (!block.empty()) lines.Push(std::move(block));
+					break;
+				}
+
+				// the rest of an overlong line
+				if (skipping) {
+					const size_t eol = block.find('\n');
+					if (eol == std::string::npos) {
+						carry.clear();
+						continue;
+					}
+					block.erase(0, eol + 1);
+					skipping = false;
+				}
+
+				const size_t eol = block.rfind('\n');
+				carry.clear();
+				if (eol != std::string::npos) {
+					carry.assign(block, eol + 1, std::string::npos);
+					block.resize(eol + 1);
+				} else {
+					carry.swap(block);
+				}
+				if (carry.size() > MAX_LINE_LENGTH) {
+					carry.clear();
+					skipping = true;
+					overlong++;
+				}
+				if (eol == std::string::npos) continue;
+				if (!lines.Push(std::move(block))) break;
+			}
+		} catch (...) {
+			readError = std::current_exception();
+			records.Close();
+		}
+		lines.Close();
+		});
+
+	// lines to filtered word and count records
+	std::thread filter([&] {
+		try {
+			std::string block, out, word;
+			while (lines.Pop(block)) {
+				std::string_view rest(block);
+				while (!rest.empty()) {
+					size_t eol = rest.find('\n');
+					std::string_view line = rest.substr(0, eol);
+					rest.remove_prefix(eol == std::string_view::npos ? rest.size() : eol + 1);
+					if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+					lineCount++;
+
+					const size_t space = line.find_first_of(" \t");
+					uint64_t count = 1;
+					if (space != std::string_view::npos && !_parse_count(line.substr(space), count)) {
+						rejected++;
+						continue;
+					}
+
+					word.assign(line.substr(0, space));
+					if (Keep(word)) _append_record(out, word, count);
+					else rejected++;
+				}
+				if (out.size() >= BLOCK_SIZE) {
+					if (!records.Push(std::move(out))) break;
+					out.clear();
+				}
+			}
+			if (!out.empty()) records.Push(std::move(out));
+		} catch (...) {
+			filterError = std::current_exception();
+			lines.Close();
+		}
+		records.Close();
+		});
+
+	// the calling thread is the sort stage
+	std::exception_ptr sortError;
+	try {
+		std::string block;
+		while (records.Pop(block)) {
+			const char* pos = block.data();
+			const char* end = pos + block.size();
+			while (pos < end) {
+				const size_t len = (uint8_t)*pos++;
+				uint64_t count;
+				std::memcpy(&count, pos + len, sizeof(count));
+				runs.Add({ pos, len }, count);
+				pos += len + sizeof(count);
+			}
+		}
+		runs.Finish();
+	} catch (...) {
+		sortError = std::current_exception();
+		records.Close();
+		lines.Close();
+	}
+
+	reader.join();
+	filter.join();
+	if (readError) std::rethrow_exception(readError);
+	if (filterError) std::rethrow_exception(filterError);
+	if (sortError) std::rethrow_exception(sortError);
+	stats.lines += lineCount + overlong;
+	stats.rejected += rejected + overlong;
+}
+
+bool WordPipeline::Keep(std::string& word) const {
+	if (word.empty() || word.length() > UINT8_MAX) return false;
+	if (options.minLength && word.length() < options.minLength) return false;
+	if (options.maxLength && word.length() > options.maxLength) return false;
+
+	switch (options.caseMode) {
+	case CaseMode::LOWER_ONLY:
+		return CharClass::AllLetters(word, true);
+	case CaseMode::FOLD:
+		return CharClass::ToLower(word);
+	default:
+		return CharClass::AllLetters(word);
+	}
+}
@@ -0,0 +1,74 @@
+#ifndef WORD_PIPELINE_H
+#define WORD_PIPELINE_H
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+// Curates word lists too big to load as a Dictionary. Lines stream through
+// read, filter and sort stages that run on their own threads and hand blocks
+// to each other over bounded queues. The sort stage keeps runs within the
+// memory budget, spilling sorted runs to temporary files and merging them at
+// the end, so memory use doesn't grow with the input.
+//
+// Every line is a word optionally followed by whitespace and a count, which
+// defaults to 1. Lines with anything else after the word are rejected, like
+// Dictionary rejects them. Counts of duplicate words are added up. Output is sorted by
+// length then alphabetically like a Dictionary, with duplicates removed.
+class WordPipeline {
+public:
+	enum class CaseMode {
+		// only keep words that are all ASCII letters
+		LETTERS,
+		// only keep words that are all lowercase letters, like SanitizeToLower
+		LOWER_ONLY,
+		// lowercase words that are all letters
+		FOLD,
+	};
+
+	enum class Format {
+		// compiled dictionary, as written by Dictionary::Save, weighted by
+		// count when joining frequencies
+		BINARY,
+		// one word per line, followed by its count when joining frequencies
+		TEXT,
+		// header of words for StaticDictionary, see embedded_dictionary.cpp
+		HEADER,
+	};
+
+	struct Options {
+		CaseMode caseMode = CaseMode::LETTERS;
+		// inclusive length range, 0 for no limit. Words are at most 255 letters.
+		size_t minLength = 0, maxLength = 0;
+		// when set, only words listed in this file are kept and take their
+		// counts from it. It goes through the same filters as the input.
+		std::filesystem::path frequencies;
+		uint64_t minCount = 0;
+		// bytes of words the sort stage holds before spilling a run
+		size_t memoryBudget = 256 << 20;
+		std::filesystem::path tempDir;
+	};
+
+	struct Stats {
+		// rejected lines failed the format or the filters
+		size_t lines = 0, rejected = 0, words = 0, spilledRuns = 0;
+	};
+
+	WordPipeline(const Options& options);
+	virtual ~WordPipeline() {}
+
+	// An input of "-" reads standard input
+	Stats Run(const std::string& input, const std::filesystem::path& output, Format format);
+
+private:
+	class SortedRuns;
+
+	void Sort(const std::string& input, SortedRuns& runs, Stats& stats) const;
+	bool Keep(std::string& word) const;
+
+	Options options;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#include "word_set.hpp"
+
+#define HASH_MULTIPLIER 0x9E3779B97F4A7C15ull
+
+template<typename T>
+void WordSet::Table<T>::Build(const std::vector<T>& codes) {
+	if (codes.empty()) return;
+
+	// keep the load factor at or below one half
+	size_t capacity = 16;
+	shift = 60;
+	while (capacity < codes.size() * 2) { capacity <<= 1; shift--; }
+
+	slots.assign(capacity, 0);
+	for (T code : codes) {
+		size_t i = (size_t)(((uint64_t)code * HASH_MULTIPLIER) >> shift);
+		while (slots[i] != 0 && slots[i] != code) i = (i + 1) & (capacity - 1);
+		slots[i] = code;
+	}
+}
+
+template<typename T>
+bool WordSet::Table<T>::Contains(T code) const {
+	if (slots.empty()) return false;
+
+	size_t i = (size_t)(((uint64_t)code * HASH_MULTIPLIER) >> shift);
+	while (slots[i] != 0) {
+		if (slots[i] == code) return true;
+		i = (i + 1) & (slots.size() - 1);
+	}
+	return false;
+}
+
+WordSet::WordSet(const Dictionary* dict)
+	: fallback(dict), count(0) {
+	std::array<std::vector<uint64_t>, MaxPackedLength + 1> codes;
+	for (size_t i = 0; i < dict->WordCount(); ++i) {
+		const auto word = dict->GetWord(i);
+		const auto code = Pack(word);
+		if (code) codes[word.length()].push_back(*code);
+	}
+
+	for (size_t len = 1; len <= MaxPackedLength; ++len) {
+		count += codes[len].size();
+		if (len <= MaxNarrowLength) {
+			narrow[len].Build(std::vector<uint32_t>(codes[len].begin(), codes[len].end()));
+		} else {
+			wide[len].Build(codes[len]);
+		}
+	}
+}
+
+bool WordSet::Contains(std::string_view str) const {
+	const auto code = Pack(str);
+	if (!code) return fallback->Contains(str);
+
+	if (str.length() <= MaxNarrowLength) return narrow[str.length()].Contains((uint32_t)*code);
+	return wide[str.length()].Contains(*code);
+}
+
+std::optional<uint64_t> WordSet::Pack(std::string_view str) {
+	if (str.empty() || str.length() > MaxPackedLength) return std::nullopt;
+
+	// 'a' packs to 1 so no word has the empty slot code 0
+	uint64_t code = 0;
+	for (char c : str) {
+		if ('a' > c || c > 'z') return std::nullopt;
+		code = (code << 5) | (uint64_t)(c - 'a' + 1);
+	}
+	return code;
+}
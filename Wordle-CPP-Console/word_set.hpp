@@ -0,0 +1,47 @@
+#ifndef WORD_SET_H
+#define WORD_SET_H
+
+#include "dictionary.hpp"
+
+#include <stdint.h>
+
+#include <array>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// Membership index over a Dictionary. Lowercase words are packed 5 bits per
+// letter into an integer and stored in per-length open addressing tables, so
+// Contains is a hash and a couple of integer compares. Words that can't be
+// packed (upper case, longer than MaxPackedLength) are looked up in the
+// dictionary the set was built from.
+class WordSet {
+public:
+	static constexpr size_t MaxPackedLength = 12;
+	static constexpr size_t MaxNarrowLength = 6;
+
+	WordSet(const Dictionary* dict);
+
+	bool Contains(std::string_view str) const;
+	size_t WordCount() const { return count; }
+
+	static std::optional<uint64_t> Pack(std::string_view str);
+
+private:
+	template<typename T>
+	struct Table {
+		std::vector<T> slots;
+		size_t shift = 64;
+
+		void Build(const std::vector<T>& codes);
+		bool Contains(T code) const;
+	};
+
+	// words up to 6 letters fit in 30 bits
+	std::array<Table<uint32_t>, MaxNarrowLength + 1> narrow;
+	std::array<Table<uint64_t>, MaxPackedLength + 1> wide;
+	const Dictionary* fallback;
+	size_t count;
+};
+
+#endif
@@ -1,4 +1,7 @@
 #include "wordle_board.hpp"
+#include "renderer.hpp"
+#include "char_class.hpp"
+#include "thread_rng.hpp"
 
 #include <iostream>
 #include <algorithm>
@@ -138,85 +141,60 @@ int board_insert_guess(board_t* brd, const char* guess) {
 }
 */
 
-const std::string_view _formats[] = { "\033[0m", "\033[30;1m", "\033[33;1m", "\033[32;1m" };
-
-Board::Board(uint8_t trys, Dictionary* dict, size_t minWordLen, size_t maxWordLen)
-	: currentRow(0), attempts(trys) {
-	if (minWordLen > maxWordLen) std::swap(minWordLen, maxWordLen);
-	size_t len = (rand() % (maxWordLen - minWordLen + 1)) + minWordLen;
-	wordLen = len;
-
-	board.resize(attempts * len);
-	std::for_each(board.begin(), board.end(), [](std::pair<char, Board::Fmt>& val) {
-		val = { ' ', Fmt::Reset };
-	});
+Board::Board(uint8_t trys, const Dictionary* dict, size_t minWordLen, size_t maxWordLen)
+	: currentRow(0), attempts(trys), lastPattern(0) {
+	Reset(dict, minWordLen, maxWordLen);
+}
 
-	auto* dict_copy = new Dictionary(*dict);
-	dict_copy->SanitizeToLength(len);
-	answer = dict_copy->GetWord(rand() % dict_copy->WordCount());
-	delete dict_copy;
+Board::Board(uint8_t trys, std::string_view answer)
+	: attempts(trys), currentRow(0), lastPattern(0) {
+	Reset(answer);
 }
 
-Board::Board(uint8_t trys, const std::string& answer) 
-	: attempts(trys), currentRow(0) {
+void Board::Reset(std::string_view answer) {
 	size_t len = answer.size();
-	auto check = std::find_if(answer.cbegin(), answer.cend(), [](char c) { return !std::isalpha(c); });
-	if (len == 0 || check != answer.cend()) throw std::invalid_argument("Please pass a valid answer argument");
+	if (len == 0 || len > Feedback::MaxLength || !CharClass::AllLetters(answer)) throw std::invalid_argument("Please pass a valid answer argument");
+
 	wordLen = len;
+	currentRow = 0;
+	lastPattern = 0;
+	letters.assign(attempts * len, ' ');
+	patterns.assign(attempts, EmptyRow);
 
-	board.resize(len * attempts);
-	std::for_each(board.begin(), board.end(), [](std::pair<char, Board::Fmt>& val) {
-		val = { ' ', Fmt::Reset };
-	});
+	this->answer.assign(answer);
+	answerWord = Feedback::Load(this->answer);
+}
 
-	this->answer = answer;
+void Board::Reset(const Dictionary* dict, size_t minWordLen, size_t maxWordLen) {
+	auto& rng = thread_rng();
+	if (minWordLen > maxWordLen) std::swap(minWordLen, maxWordLen);
+	std::uniform_int_distribution<size_t> lengths(minWordLen, maxWordLen);
+
+	Reset(dict->RandomWord(lengths(rng), rng));
 }
 
-void Board::Print() const {
-	for (size_t i = 0; i < attempts; ++i) {
-		for (size_t j = 0; j < wordLen; ++j) {
-			std::cout << "----";
-		}
-		std::cout << std::endl;
+std::pair<char, Board::Fmt> Board::GetCell(size_t row, size_t col) const {
+	const char letter = letters[row * wordLen + col];
+	if (patterns[row] == EmptyRow) return { letter, Fmt::Reset };
 
-		for (size_t j = 0; j < wordLen; j++) {
-			const auto& pair = board[i * wordLen + j];
-			std::cout << "| " << _formats[(size_t)pair.second] << pair.first << _formats[0] << " ";
-		}
+	// Feedback results are Grey = 0, Yellow = 1, Green = 2
+	return { letter, (Fmt)(Feedback::At(patterns[row], col) + 1) };
+}
 
-		std::cout << '|' << std::endl;
-	}
-	for (size_t j = 0; j < wordLen; ++j) {
-		std::cout << "----";
-	}
-	std::cout << std::endl;
-#ifdef _DEBUG
-	std::cout << "Answer is " << std::quoted(answer) << ", current row: " << currentRow << std::endl;
-#endif
+void Board::Print() const {
+	static thread_local Renderer renderer;
+	renderer.Draw(*this);
 }
 
-int Board::InsertGuess(const std::string& guess) {
-	for (size_t i = 0; i < wordLen; ++i) {
-		auto& pair = board[currentRow * wordLen + i];
-		pair.first = guess[i];
-		const auto& idx = std::find(answer.cbegin(), answer.cend(), guess[i]);
-		if (answer[i] == guess[i]) {
-			pair.second = Fmt::Green;
-		}
-		else if (idx != answer.cend()) {
-			pair.second = Fmt::Yellow;
-		}
-		else {
-			pair.second = Fmt::Grey;
-		}
-	}
-	if (answer == guess) {
-		std::cout << "You win!!" << std::endl;
-		return 1;
-	}
-	if (++currentRow >= attempts) {
-		std::cout << "You lose!" << std::endl;
-		return 2;
-	}
+int Board::InsertGuess(std::string_view guess) {
+	if (guess.length() != wordLen) throw std::invalid_argument("Guess length doesn't match the board");
+
+	const uint32_t pattern = Feedback::Score(Feedback::Load(guess), answerWord, wordLen);
+	lastPattern = pattern;
+	patterns[currentRow] = pattern;
+	std::copy(guess.begin(), guess.end(), letters.begin() + currentRow * wordLen);
+
+	if (pattern == Feedback::AllGreen(wordLen)) return 1;
+	if (++currentRow >= attempts) return 2;
 	return 0;
 }
@@ -2,8 +2,10 @@
 #define WORDLE_BOARD_H
 
 #include "dictionary.hpp"
+#include "feedback.hpp"
 
 #include <cstddef>
+#include <string_view>
 #include <utility>
 
 /*typedef struct _board_struct {
@@ -24,25 +26,48 @@ int board_insert_guess(board_t* brd, const char* guess);*/
 
 class Board {
 public:
-	Board(uint8_t attempts, Dictionary* dict, size_t minWordLen, size_t maxWordLen);
-	Board(uint8_t attempts, const std::string& answer);
+	enum class Fmt : uint8_t {
+		Reset = 0, Grey = 1, Yellow = 2, Green = 3
+	};
+
+	Board(uint8_t attempts, const Dictionary* dict, size_t minWordLen, size_t maxWordLen);
+	Board(uint8_t attempts, std::string_view answer);
 	virtual ~Board() {}
 
+	// Starts a new game on the same board, keeping attempts and reusing the
+	// storage when the new answer is not longer than the old one
+	void Reset(std::string_view answer);
+	void Reset(const Dictionary* dict, size_t minWordLen, size_t maxWordLen);
+
 	void Print() const;
-	int InsertGuess(const std::string& guess);
+	// 0 while the game goes on, 1 when guess is the answer and 2 when the
+	// board ran out of attempts
+	int InsertGuess(std::string_view guess);
 
 	const std::string& GetAnswer() const { return answer; }
 	size_t GetLength() const { return wordLen; }
+	size_t GetAttempts() const { return attempts; }
+	size_t GetCurrentRow() const { return currentRow; }
+	std::pair<char, Fmt> GetCell(size_t row, size_t col) const;
+	const char* GetRowLetters(size_t row) const { return letters.data() + row * wordLen; }
+	// Feedback pattern of a row, EmptyRow until a guess is inserted there
+	uint32_t GetRowPattern(size_t row) const { return patterns[row]; }
+	bool IsRowSolved(size_t row) const { return patterns[row] == Feedback::AllGreen(wordLen); }
+	// Feedback pattern of the most recent guess
+	uint32_t GetLastPattern() const { return lastPattern; }
 
-private:
-	enum class Fmt : uint8_t {
-		Reset = 0, Grey = 1, Yellow = 2, Green = 3
-	};
+	static constexpr uint32_t EmptyRow = UINT32_MAX;
 
+private:
 	std::string answer;
+	Feedback::Word answerWord;
 	size_t attempts, wordLen, currentRow;
+	uint32_t lastPattern;
 
-	std::vector<std::pair<char, Fmt>> board;
+	// letters row major, one Feedback pattern per row. Copying a board is a
+	// snapshot of the game.
+	std::vector<char> letters;
+	std::vector<uint32_t> patterns;
 
 };
 
@@ -0,0 +1,116 @@
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "word_pipeline.hpp"
+#include "getopt.h"
+
+// Build step that turns a word list into a compiled dictionary, or into a
+// header of sorted words that StaticDictionary compiles into the game. Lists
+// stream through WordPipeline, so corpora of any size fit in the budget.
+
+void print_help(void);
+bool parse_number(const char* str, unsigned long long* out);
+
+int main(int argc, char* argv[]) {
+	int opt = 0;
+	WordPipeline::Options options;
+	WordPipeline::Format format = WordPipeline::Format::BINARY;
+	unsigned long long parse, parseMax;
+	char* dash;
+	while ((opt = getopt(argc, argv, "cef:hlm:M:n:tT:")) != -1) {
+		switch (opt) {
+		case 'c':
+			options.caseMode = WordPipeline::CaseMode::FOLD;
+			break;
+		case 'e':
+			format = WordPipeline::Format::HEADER;
+			break;
+		case 'f':
+			options.frequencies = optarg;
+			break;
+		case 'l':
+			options.caseMode = WordPipeline::CaseMode::LOWER_ONLY;
+			break;
+		case 'm':
+			if (!parse_number(optarg, &parse)) {
+				puts("Unable to parse number after -m");
+				print_help();
+				return EXIT_FAILURE;
+			}
+			options.minCount = parse;
+			break;
+		case 'M':
+			if (!parse_number(optarg, &parse) || parse == 0) {
+				puts("Unable to parse number after -M");
+				print_help();
+				return EXIT_FAILURE;
+			}
+			options.memoryBudget = (size_t)parse << 20;
+			break;
+		case 'n':
+			dash = strchr(optarg, '-');
+			if (dash) *dash = '\0';
+			if (!parse_number(optarg, &parse) || (dash && !parse_number(dash + 1, &parseMax))) {
+				puts("Unable to parse length after -n");
+				print_help();
+				return EXIT_FAILURE;
+			}
+			options.minLength = parse;
+			options.maxLength = dash ? parseMax : parse;
+			break;
+		case 't':
+			format = WordPipeline::Format::TEXT;
+			break;
+		case 'T':
+			options.tempDir = optarg;
+			break;
+		case '?':
+		case 'h':
+			print_help();
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (argc - optind != 2) {
+		print_help();
+		return EXIT_FAILURE;
+	}
+
+	try {
+		WordPipeline pipeline(options);
+		const auto stats = pipeline.Run(argv[optind], std::filesystem::path(argv[optind + 1]), format);
+		std::cout << "Compiled " << stats.words << " words from " << stats.lines << " lines to " << argv[optind + 1];
+		if (stats.rejected) std::cout << ", " << stats.rejected << " lines rejected";
+		if (stats.spilledRuns) std::cout << ", sorted in " << stats.spilledRuns << " runs on disk";
+		std::cout << std::endl;
+	} catch (const std::exception& e) {
+		std::cerr << "wordle-dict: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+void print_help(void) {
+	std::cout << "Usage: wordle-dict [options] input output" << std::endl;
+	std::cout << "Input is a word per line, optionally followed by a count, or - for standard input." << std::endl;
+	std::cout << " -c       \t Lowercase words instead of skipping ones with uppercase letters." << std::endl;
+	std::cout << " -e       \t Write a C++ header with the sorted words instead of a binary file." << std::endl;
+	std::cout << " -f file  \t Only keep words listed in this frequency file, with its counts as weights." << std::endl;
+	std::cout << " -l       \t Skip words with anything but lowercase letters." << std::endl;
+	std::cout << " -m num   \t Skip words counted fewer than num times." << std::endl;
+	std::cout << " -M mb    \t Memory for sorting before spilling to temporary files. (default=256)" << std::endl;
+	std::cout << " -n len   \t Only keep words of this length, or of a range like 4-8." << std::endl;
+	std::cout << " -t       \t Write a text list instead of a binary file, with counts when joining." << std::endl;
+	std::cout << " -T dir   \t Directory for temporary files." << std::endl;
+}
+
+bool parse_number(const char* str, unsigned long long* out) {
+	if (str[0] < '0' || str[0] > '9') return false;
+	char* end;
+	errno = 0;
+	*out = strtoull(str, &end, 10);
+	return errno != ERANGE && *end == '\0';
+}
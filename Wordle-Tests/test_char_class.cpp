@@ -0,0 +1,56 @@
+// CharClass kernels against a scalar reference, for every byte value at
+// every position of strings up to 70 bytes so each SIMD block and tail is
+// covered. ctest runs it again with WORDLE_SIMD capping the kernel, so the
+// SSE2 and scalar kernels are checked on AVX2 machines too.
+#include "test_util.hpp"
+
+#include "char_class.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#define MAX_TEST_LENGTH 70
+
+static bool reference_letters(const std::string& str, bool lowerOnly) {
+	for (char c : str) {
+		if (!((c >= 'a' && c <= 'z') || (!lowerOnly && c >= 'A' && c <= 'Z'))) return false;
+	}
+	return true;
+}
+
+static void check_string(const std::string& str) {
+	CHECK(CharClass::AllLetters(str) == reference_letters(str, false));
+	CHECK(CharClass::AllLetters(str, true) == reference_letters(str, true));
+
+	std::string lowered = str;
+	const bool letters = CharClass::ToLower(lowered);
+	CHECK(letters == reference_letters(str, false));
+	if (letters) {
+		for (size_t i = 0; i < str.length(); ++i) CHECK(lowered[i] == (char)(str[i] | 0x20));
+	}
+}
+
+int main() {
+	// the cap has to reach the dispatch, or the runs below test one kernel
+	const char* cap = std::getenv("WORDLE_SIMD");
+	const char* picked = CharClass::Implementation();
+	if (cap && std::strcmp(cap, "scalar") == 0) CHECK(std::strcmp(picked, "scalar") == 0);
+	if (cap && std::strcmp(cap, "sse2") == 0) CHECK(std::strcmp(picked, "avx2") != 0);
+
+	CHECK(CharClass::AllLetters(""));
+	for (size_t len = 1; len <= MAX_TEST_LENGTH; ++len) {
+		// mixed case letters, so ToLower has something to do in every lane
+		std::string base(len, 'a');
+		for (size_t i = 0; i < len; ++i) base[i] = (char)((i % 3 ? 'a' : 'A') + i % 26);
+
+		for (size_t pos = 0; pos < len; ++pos) {
+			for (int c = 0; c < 256; ++c) {
+				std::string str = base;
+				str[pos] = (char)c;
+				check_string(str);
+			}
+		}
+	}
+	return test_result();
+}
@@ -0,0 +1,67 @@
+// Lookups from every hardware thread into one shared Dictionary, WordSet and
+// unsorted dict_t. The results are checked here, the races by building with
+// -DWORDLE_SANITIZER=thread.
+#include "test_util.hpp"
+
+#include "dictionary.hpp"
+#include "word_set.hpp"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define ROUNDS 2
+
+// dict_t side, in test_concurrency_c.cpp because dictionary.h and
+// dictionary.hpp share an include guard
+const void* c_dictionary_load(const std::vector<std::string>& words);
+void c_dictionary_check(const void* dict, const std::string& probe, bool expected);
+void c_dictionary_destroy(const void* dict);
+
+int main() {
+	const auto words = test_words(20000, 4, 8, 1);
+	const std::set<std::string> known(words.begin(), words.end());
+	// half the probes are in the lists
+	auto probes = test_words(2000, 4, 8, 2);
+	probes.insert(probes.end(), words.begin(), words.begin() + 2000);
+
+	const Dictionary dict(words, Dictionary::LoadFlags::LOWER_ONLY);
+	const WordSet set(&dict);
+
+	const void* unsorted = c_dictionary_load(words);
+	if (!CHECK(unsorted != nullptr)) return test_result();
+
+	const size_t threadCount = std::max(2u, std::thread::hardware_concurrency());
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&, t] {
+			std::mt19937_64 rng(t);
+			for (size_t round = 0; round < ROUNDS; ++round) {
+				// every thread walks the probes from its own offset
+				for (size_t n = 0; n < probes.size(); ++n) {
+					const std::string& probe = probes[(n + t * 97) % probes.size()];
+					const bool expected = known.count(probe) != 0;
+
+					CHECK(dict.Contains(probe) == expected);
+					CHECK(set.Contains(probe) == expected);
+
+					const auto index = dict.IndexOf(probe);
+					CHECK(index.has_value() == expected);
+					if (index) CHECK(dict.GetWord(*index) == probe);
+
+					c_dictionary_check(unsorted, probe, expected);
+
+					const auto random = dict.RandomWord(probe.length(), rng);
+					CHECK(random.length() == probe.length() && known.count(std::string(random)) != 0);
+				}
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+
+	c_dictionary_destroy(unsorted);
+	return test_result();
+}
@@ -0,0 +1,28 @@
+#include "test_util.hpp"
+
+extern "C" {
+#include "dictionary.h"
+}
+
+#include <string>
+#include <vector>
+
+// Not alphabetized, the case that used to sort the shared list on first use
+const void* c_dictionary_load(const std::vector<std::string>& words) {
+	std::vector<const char*> list;
+	for (const auto& word : words) list.push_back(word.c_str());
+	return dictionary_from_str_array(list.size(), list.data(), DICT_LOAD_LOWER_ONLY | DICT_LOAD_DONT_ALPHABETIZE);
+}
+
+void c_dictionary_check(const void* dict, const std::string& probe, bool expected) {
+	const dict_t* unsorted = (const dict_t*)dict;
+	CHECK(dictionary_contains(unsorted, probe.c_str()) == expected);
+
+	const int64_t index = dictionary_index_of(unsorted, probe.c_str());
+	CHECK((index >= 0) == expected);
+	if (index >= 0) CHECK(probe == dictionary_get_word(unsorted, (size_t)index));
+}
+
+void c_dictionary_destroy(const void* dict) {
+	dictionary_destroy((dict_t*)dict);
+}
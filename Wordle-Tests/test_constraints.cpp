@@ -0,0 +1,60 @@
+// Constraints against brute force: after every guess of a game, a word is
+// allowed exactly when scoring each earlier guess against it reproduces the
+// pattern that guess got.
+#include "test_util.hpp"
+
+#include "constraints.hpp"
+#include "dictionary.hpp"
+#include "feedback.hpp"
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#define GAMES 200
+#define GUESSES 6
+
+static void play_games(const Dictionary& dict, size_t len, uint64_t seed) {
+	const auto words = dict.WordsOfLength(len);
+	Constraints constraints(words);
+	std::mt19937_64 rng(seed);
+
+	for (size_t game = 0; game < GAMES; ++game) {
+		constraints.Reset();
+		const std::string_view answer = words[rng() % words.size()];
+
+		std::vector<std::pair<std::string_view, uint32_t>> history;
+		for (size_t turn = 0; turn < GUESSES; ++turn) {
+			const std::string_view guess = words[rng() % words.size()];
+			const uint32_t pattern = Feedback::Score(guess, answer);
+			constraints.Update(guess, pattern);
+			history.push_back({ guess, pattern });
+
+			std::vector<std::string_view> expected;
+			for (const auto& word : words) {
+				bool fits = true;
+				for (const auto& [previous, seen] : history) fits = fits && reference_score(previous, word) == seen;
+				if (fits) expected.push_back(word);
+
+				CHECK(constraints.Allows(word) == fits);
+				CHECK(constraints.Violation(word).empty() == fits);
+			}
+			CHECK(constraints.GetCandidates() == expected);
+			CHECK(constraints.Allows(answer));
+		}
+	}
+}
+
+int main() {
+	// few letters, so feedback is full of repeated letter counts
+	auto list = test_words(3000, 5, 5, 11, 6);
+	const auto longer = test_words(3000, 7, 7, 12, 5);
+	list.insert(list.end(), longer.begin(), longer.end());
+	const Dictionary dict(list);
+
+	play_games(dict, 5, 1);
+	play_games(dict, 7, 2);
+	return test_result();
+}
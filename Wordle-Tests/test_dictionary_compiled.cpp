@@ -0,0 +1,61 @@
+// Compiled dictionaries read back from Serialize, and truncated or corrupted
+// copies that have to be rejected before anything is read out of bounds.
+#include "test_util.hpp"
+
+#include "dictionary.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// FileHeader fields and the bucket table, see dictionary.cpp
+#define MAX_LENGTH_AT 12
+#define WORD_COUNT_AT 16
+#define BUCKET_AT(len) (24 + (len) * 16)
+
+template<typename T>
+static std::string with(std::string data, size_t at, T value) {
+	std::memcpy(&data[at], &value, sizeof(value));
+	return data;
+}
+
+static bool rejected(const std::string& data) {
+	try {
+		Dictionary(data.data(), data.size());
+	} catch (const std::runtime_error&) {
+		return true;
+	}
+	return false;
+}
+
+int main() {
+	const Dictionary source(std::vector<std::string>{ "crane 10", "slate", "tea", "trace 3", "abcd" });
+	const std::string data = source.Serialize();
+
+	const Dictionary loaded(data.data(), data.size());
+	if (CHECK(loaded.WordCount() == source.WordCount())) {
+		for (size_t i = 0; i < source.WordCount(); ++i) {
+			CHECK(loaded.GetWord(i) == source.GetWord(i));
+			CHECK(loaded.GetWeight(i) == source.GetWeight(i));
+		}
+	}
+
+	// words and weights end the file, every shorter copy is missing some
+	for (size_t size = 0; size < data.size(); ++size) CHECK(rejected(data.substr(0, size)));
+
+	CHECK(rejected(with<uint32_t>(data, MAX_LENGTH_AT, UINT32_MAX)));
+	CHECK(rejected(with<uint32_t>(data, MAX_LENGTH_AT, 1000)));
+	CHECK(rejected(with<uint64_t>(data, WORD_COUNT_AT, UINT64_MAX)));
+	CHECK(rejected(with<uint64_t>(data, WORD_COUNT_AT, source.WordCount() + 1)));
+	// an offset that wraps around, and a count whose byte size does
+	CHECK(rejected(with<uint64_t>(data, BUCKET_AT(5), UINT64_MAX - 2)));
+	CHECK(rejected(with<uint64_t>(data, BUCKET_AT(4) + 8, 1ull << 62)));
+	// words inside the header, and buckets out of length order
+	CHECK(rejected(with<uint64_t>(data, BUCKET_AT(3), 0)));
+	CHECK(rejected(with<uint64_t>(data, BUCKET_AT(5), BUCKET_AT(6))));
+	// words of no letters
+	CHECK(rejected(with<uint64_t>(data, BUCKET_AT(0) + 8, 1)));
+
+	return test_result();
+}
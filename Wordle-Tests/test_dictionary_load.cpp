@@ -0,0 +1,122 @@
+// Text dictionaries loaded from a file big enough for the parallel chunked
+// loader, from the same lines on the serial path, and by a reference filter
+// and sort, for every flag combination.
+#include "test_util.hpp"
+
+#include "dictionary.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct Entry {
+	std::string word;
+	double weight;
+};
+
+// The weight column varies by line, so copies of a word disagree on it and
+// only the first copy's may survive deduplication
+static std::string weight_column(size_t line) {
+	const size_t h = line * 2654435761u;
+	return h % 3 == 0 ? "" : " " + std::to_string(h % 100);
+}
+
+static std::vector<std::string> make_lines() {
+	auto words = test_words(160000, 1, 12, 7, 6);
+	std::vector<std::string> lines;
+	for (size_t i = 0; i < words.size(); ++i) {
+		std::string line = words[i];
+		switch (i % 16) {
+		case 0: line[0] = (char)(line[0] - 'a' + 'A'); break;
+		case 1: line += "-x"; break;
+		case 2: line += " cream"; break;
+		case 3: line.clear(); break;
+		}
+		if (i % 16 != 2) line += weight_column(i);
+		if (i % 5 == 0) line += "\r";
+		lines.push_back(line);
+	}
+	return lines;
+}
+
+static std::vector<Entry> reference_load(const std::vector<std::string>& lines, bool lowerOnly, bool alphabetize, size_t length) {
+	std::vector<Entry> out;
+	for (std::string line : lines) {
+		if (!line.empty() && line.back() == '\r') line.pop_back();
+		double weight = 1.0;
+		const size_t space = line.find(' ');
+		if (space != std::string::npos) {
+			char* end;
+			const double parsed = strtod(line.c_str() + space, &end);
+			if (end != line.c_str() + space && *end == '\0') {
+				weight = parsed;
+				line.resize(space);
+			}
+		}
+
+		bool letters = !line.empty();
+		for (char c : line) letters = letters && ((c >= 'a' && c <= 'z') || (!lowerOnly && c >= 'A' && c <= 'Z'));
+		if (letters && (!length || line.length() == length)) out.push_back({ line, weight });
+	}
+
+	if (alphabetize) {
+		std::stable_sort(out.begin(), out.end(), [](const Entry& a, const Entry& b) {
+			return a.word.length() != b.word.length() ? a.word.length() < b.word.length() : a.word < b.word;
+		});
+		out.erase(std::unique(out.begin(), out.end(), [](const Entry& a, const Entry& b) { return a.word == b.word; }), out.end());
+	} else {
+		std::stable_sort(out.begin(), out.end(), [](const Entry& a, const Entry& b) { return a.word.length() < b.word.length(); });
+	}
+	return out;
+}
+
+static void check_equal(const Dictionary& dict, const std::vector<Entry>& expected) {
+	if (!CHECK(dict.WordCount() == expected.size())) return;
+	for (size_t i = 0; i < expected.size(); ++i) {
+		CHECK(dict.GetWord(i) == expected[i].word);
+		CHECK(dict.GetWeight(i) == expected[i].weight);
+	}
+}
+
+int main() {
+	const auto lines = make_lines();
+	const auto path = std::filesystem::temp_directory_path() / "wordle_test_dictionary_load.txt";
+	{
+		std::ofstream f{ path, std::ios::binary | std::ios::trunc };
+		for (const auto& line : lines) f << line << '\n';
+	}
+	CHECK(std::filesystem::file_size(path) >= Dictionary::ParallelLoadSize);
+
+	for (int lowerOnly = 0; lowerOnly <= 1; ++lowerOnly) {
+		for (int alphabetize = 0; alphabetize <= 1; ++alphabetize) {
+			uint32_t flags = 0;
+			if (lowerOnly) flags |= (uint32_t)Dictionary::LoadFlags::LOWER_ONLY;
+			if (!alphabetize) flags |= (uint32_t)Dictionary::LoadFlags::DONT_ALPHABETIZE;
+
+			const auto expected = reference_load(lines, lowerOnly, alphabetize, 0);
+			check_equal(Dictionary(path, (Dictionary::LoadFlags)flags), expected);
+			check_equal(Dictionary(lines, (Dictionary::LoadFlags)flags), expected);
+			check_equal(Dictionary(path, (Dictionary::LoadFlags)flags, 5), reference_load(lines, lowerOnly, alphabetize, 5));
+		}
+	}
+
+	// the first copy's weight, or its lack of one, wins on the serial path
+	const std::vector<std::string> duplicates{ "slate", "crane 10", "crane 3", "crane", "trace", "trace 7" };
+	{
+		std::ofstream f{ path, std::ios::binary | std::ios::trunc };
+		for (const auto& line : duplicates) f << line << '\n';
+	}
+	for (const Dictionary& dict : { Dictionary(path), Dictionary(duplicates) }) {
+		if (!CHECK(dict.WordCount() == 3)) continue;
+		CHECK(dict.GetWord(0) == "crane" && dict.GetWeight(0) == 10.0);
+		CHECK(dict.GetWord(1) == "slate" && dict.GetWeight(1) == 1.0);
+		CHECK(dict.GetWord(2) == "trace" && dict.GetWeight(2) == 1.0);
+	}
+
+	std::filesystem::remove(path);
+	return test_result();
+}
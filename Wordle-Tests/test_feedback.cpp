@@ -0,0 +1,45 @@
+// Feedback::Score against reference_score, and the repeated letter cases the
+// first kernel over-reported as yellow.
+#include "test_util.hpp"
+
+#include "feedback.hpp"
+
+#include <string>
+#include <string_view>
+
+// "G" green, "Y" yellow and "-" grey per letter, like the server protocol
+static uint32_t pattern_of(std::string_view marks) {
+	uint32_t pattern = 0;
+	for (size_t i = marks.length(); i-- > 0;) pattern = pattern * 3 + (marks[i] == 'G' ? 2 : marks[i] == 'Y' ? 1 : 0);
+	return pattern;
+}
+
+int main() {
+	// a letter is yellow at most as often as the answer has it outside greens
+	CHECK(Feedback::Score("speed", "abide") == pattern_of("--Y-Y"));
+	CHECK(Feedback::Score("eerie", "there") == pattern_of("Y-Y-G"));
+	CHECK(Feedback::Score("llama", "hello") == pattern_of("YY---"));
+	CHECK(Feedback::Score("robot", "floor") == pattern_of("YY-G-"));
+	CHECK(Feedback::Score("sassy", "essay") == pattern_of("YYG-G"));
+	CHECK(Feedback::Score("crane", "crane") == Feedback::AllGreen(5));
+	CHECK(Feedback::Score("aaaaa", "abbba") == pattern_of("G---G"));
+
+	// small alphabets so most pairs share repeated letters
+	for (size_t len = 1; len <= Feedback::MaxLength; ++len) {
+		const auto guesses = test_words(200, len, len, len, 3);
+		const auto answers = test_words(200, len, len, len + 100, 3);
+		for (const auto& guess : guesses) {
+			for (const auto& answer : answers) {
+				const uint32_t expected = reference_score(guess, answer);
+				CHECK(Feedback::Score(guess, answer) == expected);
+				CHECK(Feedback::Score(Feedback::Load(guess), Feedback::Load(answer), len) == expected);
+			}
+		}
+	}
+
+	const uint32_t pattern = pattern_of("G-Y");
+	CHECK(Feedback::At(pattern, 0) == Feedback::Green);
+	CHECK(Feedback::At(pattern, 1) == Feedback::Grey);
+	CHECK(Feedback::At(pattern, 2) == Feedback::Yellow);
+	return test_result();
+}
@@ -0,0 +1,52 @@
+// Feedback::Score<N> against the runtime kernel and reference_score, on
+// both sides of the 6 letter switch to the count table, and FixedBoard<N>
+// games against Board.
+#include "test_util.hpp"
+
+#include "feedback.hpp"
+#include "fixed_board.hpp"
+#include "wordle_board.hpp"
+
+#include <array>
+#include <string>
+
+#define ATTEMPTS 6
+
+template<size_t N>
+static void check_length(uint64_t seed) {
+	const auto guesses = test_words(300, N, N, seed, 3);
+	const auto answers = test_words(300, N, N, seed + 100, 3);
+	for (const auto& answer : answers) {
+		const auto answerWord = FixedBoard<N>::Load(answer);
+		for (const auto& guess : guesses) {
+			const uint32_t expected = reference_score(guess, answer);
+			CHECK(Feedback::Score<N>(FixedBoard<N>::Load(guess), answerWord) == expected);
+			CHECK(Feedback::Score(guess, answer) == expected);
+		}
+	}
+
+	// the same games on both boards, ending in a win or a loss
+	for (size_t game = 0; game < answers.size(); ++game) {
+		FixedBoard<N> fixed(ATTEMPTS, answers[game]);
+		Board board(ATTEMPTS, answers[game]);
+		for (size_t turn = 0; turn < ATTEMPTS; ++turn) {
+			const std::string& guess = turn == game % (ATTEMPTS + 1) ? answers[game] : guesses[(game + turn) % guesses.size()];
+			const int res = fixed.InsertGuess(guess);
+			CHECK(res == board.InsertGuess(guess));
+			CHECK(fixed.GetLastPattern() == board.GetLastPattern());
+			CHECK(fixed.GetRowPattern(turn) == board.GetRowPattern(turn));
+			if (res != 0) break;
+		}
+	}
+}
+
+int main() {
+	check_length<1>(1);
+	check_length<4>(4);
+	check_length<5>(5);
+	check_length<6>(6);
+	check_length<7>(7);
+	check_length<8>(8);
+	check_length<12>(12);
+	return test_result();
+}
@@ -0,0 +1,65 @@
+// LetterIndex::Matches and Count against a linear filter over the words,
+// with lists that leave partial 64 and 256 bit blocks. ctest runs it again
+// with WORDLE_SIMD=scalar so both kernels are checked.
+#include "test_util.hpp"
+
+#include "dictionary.hpp"
+#include "letter_index.hpp"
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#define QUERIES 2000
+
+static bool reference_match(std::string_view word, const LetterIndex::Query& query) {
+	size_t counts[26] = {};
+	for (size_t i = 0; i < word.length(); ++i) {
+		if (query.pattern[i] != '?' && query.pattern[i] != word[i]) return false;
+		counts[word[i] - 'a']++;
+	}
+	for (size_t letter = 0; letter < 26; ++letter) {
+		if ((query.excluded >> letter & 1) && counts[letter]) return false;
+		if (counts[letter] < query.minCount[letter]) return false;
+	}
+	return true;
+}
+
+static void check_queries(const Dictionary& dict, size_t len, size_t alphabet, uint64_t seed) {
+	const auto words = dict.WordsOfLength(len);
+	const LetterIndex index(words);
+	std::mt19937_64 rng(seed);
+
+	for (size_t n = 0; n < QUERIES; ++n) {
+		// built around a word so plenty of queries match something
+		const std::string_view word = words[rng() % words.size()];
+		LetterIndex::Query query;
+		for (size_t i = 0; i < len; ++i) query.pattern += rng() % 3 == 0 ? word[i] : '?';
+		for (size_t k = rng() % 3; k > 0; --k) query.excluded |= 1u << (rng() % alphabet);
+		for (size_t k = rng() % 4; k > 0; --k) query.minCount[rng() % alphabet]++;
+
+		std::vector<uint32_t> expected;
+		for (size_t id = 0; id < words.size(); ++id) {
+			if (reference_match(words[id], query)) expected.push_back((uint32_t)id);
+		}
+		CHECK(index.Matches(query) == expected);
+		CHECK(index.Count(query) == expected.size());
+	}
+}
+
+int main() {
+	auto list = test_words(3001, 5, 5, 21, 8);
+	const auto longer = test_words(701, 8, 8, 22, 6);
+	list.insert(list.end(), longer.begin(), longer.end());
+	const Dictionary dict(list);
+
+	check_queries(dict, 5, 8, 1);
+	check_queries(dict, 8, 6, 2);
+
+	const auto query = LetterIndex::Query::Parse("G?e.s:a:rR");
+	CHECK(query.pattern == "g?e?s");
+	CHECK(query.excluded == 1u << 0);
+	CHECK(query.minCount['r' - 'a'] == 2);
+	return test_result();
+}
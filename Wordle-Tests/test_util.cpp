@@ -0,0 +1,48 @@
+#include "test_util.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+static std::atomic<size_t> failures{ 0 };
+
+bool test_check(bool ok, const char* expr, const char* file, int line) {
+	// only the first few, a broken kernel fails the same check thousands of times
+	if (!ok && failures++ < 20) std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expr);
+	return ok;
+}
+
+int test_result() {
+	if (failures == 0) return EXIT_SUCCESS;
+	std::fprintf(stderr, "%zu checks failed\n", failures.load());
+	return EXIT_FAILURE;
+}
+
+std::vector<std::string> test_words(size_t count, size_t minLen, size_t maxLen, uint64_t seed, size_t alphabet) {
+	std::mt19937_64 rng(seed);
+	std::vector<std::string> out(count);
+	for (auto& word : out) {
+		word.resize(minLen + rng() % (maxLen - minLen + 1));
+		for (char& c : word) c = (char)('a' + rng() % alphabet);
+	}
+	return out;
+}
+
+uint32_t reference_score(std::string_view guess, std::string_view answer) {
+	std::vector<int> marks(guess.length(), 0);
+	std::vector<bool> used(answer.length(), false);
+	for (size_t i = 0; i < guess.length(); ++i) {
+		if (guess[i] == answer[i]) { marks[i] = 2; used[i] = true; }
+	}
+	for (size_t i = 0; i < guess.length(); ++i) {
+		if (marks[i]) continue;
+		for (size_t j = 0; j < answer.length(); ++j) {
+			if (!used[j] && guess[i] == answer[j]) { marks[i] = 1; used[j] = true; break; }
+		}
+	}
+
+	uint32_t pattern = 0;
+	for (size_t i = guess.length(); i-- > 0;) pattern = pattern * 3 + marks[i];
+	return pattern;
+}
@@ -0,0 +1,27 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Checks for the test executables. A failed CHECK prints the expression and
+// keeps going, and main returns test_result() so ctest sees the failure.
+#define CHECK(cond) test_check((cond), #cond, __FILE__, __LINE__)
+
+bool test_check(bool ok, const char* expr, const char* file, int line);
+int test_result();
+
+// count pseudo random lowercase words of minLen to maxLen letters drawn from
+// the first alphabet letters, the same for every run with one seed. Small
+// alphabets give plenty of repeated letters.
+std::vector<std::string> test_words(size_t count, size_t minLen, size_t maxLen, uint64_t seed, size_t alphabet = 26);
+
+// Textbook two pass scoring into a Feedback pattern code: greens first, then
+// yellows left to right against answer letters no other mark used
+uint32_t reference_score(std::string_view guess, std::string_view answer);
+
+#endif
@@ -200,7 +200,7 @@ void dictionary_destroy(dict_t* dict) {
 	free((void*)dict);
 }
 
-bool dictionary_contains(dict_t* dict, const char* str)
+bool dictionary_contains(const dict_t* dict, const char* str)
 {
 	return dictionary_index_of(dict, str) >= 0;
 }
@@ -217,8 +217,15 @@ int _dictionary_index_of_compar(const void* a, const void* b) {
 	return *(const unsigned char*)aa - *(const unsigned char*)bb;
 }
 
-int64_t dictionary_index_of(dict_t* dict, const char* str) {
-	if (!dict->alphabetical) dictionary_alphabetize(dict);
+// Lookups never modify the list, so they can run from several threads. Lists
+// loaded without alphabetizing are scanned instead of sorted on demand.
+int64_t dictionary_index_of(const dict_t* dict, const char* str) {
+	if (!dict->alphabetical) {
+		for (size_t i = 0; i < dict->word_count; ++i) {
+			if (_dictionary_index_of_compar(&str, &dict->words[i]) == 0) return (int64_t)i;
+		}
+		return -1;
+	}
 
 	void* addr = bsearch(&str, dict->words, dict->word_count, sizeof(char*), _dictionary_index_of_compar);
 	if (addr == NULL) return -1;
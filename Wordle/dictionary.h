@@ -24,8 +24,8 @@ dict_t* dictionary_copy(const dict_t* dict);
 void dictionary_save(dict_t* dict, const char* out_file);
 void dictionary_destroy(dict_t* dict);
 
-bool dictionary_contains(dict_t* dict, const char* str);
-int64_t dictionary_index_of(dict_t* dict, const char* str);
+bool dictionary_contains(const dict_t* dict, const char* str);
+int64_t dictionary_index_of(const dict_t* dict, const char* str);
 const char* dictionary_get_word(const dict_t* dict, size_t index);
 size_t dictionary_word_count(const dict_t* dict);
 